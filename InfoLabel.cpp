@@ -4,20 +4,34 @@
 
 #include "InfoLabel.h"
 #include <utility>
-#include <cmath>
-#include <iomanip>
 #include <string>
-#include <sstream>
 #include <algorithm>
 #include "ui.h"
+#include "digit_readout.h"
+#include "power_gauge.h"
+#include "sparkline.h"
 
-static void anim_mask_cb(void * var, int32_t v);
+/*
+ * 读数格式：0000mA 0000mW
+ * 电流、功率各四位，前导0为灰色
+ */
+#define READOUT_TEMPLATE	"0000mA 0000mW"
+#define READOUT_DIGITS		(4)
+#define READOUT_MA_START	(0)
+#define READOUT_MW_START	(7)
+
+/*
+ * 趋势线：贴在panel内部底边，高6px
+ * 数据每500ms刷新一次，4个采样合成一个点，166px宽约能显示5分半钟的电流变化
+ */
+#define TREND_HEIGHT		(6)
+#define TREND_DECIMATION	(4)
 
 /**
  * @param ina219 用于测量总线电压电流的INA219句柄
  * @param panel lv panel控件
- * @param label 显示功率的label控件
- * @param label_mask 功率占比遮罩层
+ * @param label SquareLine生成的功率label，只用来确定读数控件的位置和字体，本身会被隐藏
+ * @param label_mask SquareLine生成的功率占比遮罩层，只用来确定占比条的大小和颜色，本身会被隐藏
  * @param active_color 有效数字颜色
  * @param non_act_color 无效数字（前导0）颜色
  * @param thsh_volt 电压阈值，低于此电压认为无效
@@ -32,14 +46,47 @@ info_label::info_label(INA219_t *ina219, lv_obj_t *panel, lv_obj_t *label, lv_ob
 {
     label_mask = power_label_mask;
 
-    lv_anim_init(&anim);
-    lv_anim_set_var(&anim, label_mask); // 设置动画作用的对象
-    lv_anim_set_exec_cb(&anim, anim_mask_cb); // 设置动画执行的回调函数
-    lv_anim_set_values(&anim, 0, 0); // 设置动画的起始值和结束值
-    lv_anim_set_time(&anim, duration); // 设置动画持续时间
-    lv_anim_set_repeat_count(&anim, 0); // 设置动画不重复
-    lv_anim_set_path_cb(&anim, lv_anim_path_linear); // 设置动画路径为线性
-    lv_anim_set_var(&anim, label_mask);
+	act_lv_color = lv_color_hex(std::stoul(this->active_color, nullptr, 16));
+	non_act_lv_color = lv_color_hex(std::stoul(this->non_act_color, nullptr, 16));
+
+	//用不透明的占比条代替整块半透明遮罩层，必须先于读数控件创建，保证文字画在占比条上面
+	gauge = power_gauge_create(panel);
+	lv_obj_set_align(gauge, lv_obj_get_style_align(label_mask, LV_PART_MAIN));
+	lv_obj_set_size(gauge, lv_obj_get_style_width(label_mask, LV_PART_MAIN),
+		lv_obj_get_style_height(label_mask, LV_PART_MAIN));
+	power_gauge_set_shade(gauge, lv_obj_get_style_bg_color(label_mask, LV_PART_MAIN),
+		lv_obj_get_style_bg_opa(label_mask, LV_PART_MAIN));
+	power_gauge_set_anim_time(gauge, duration);
+	lv_obj_add_flag(label_mask, LV_OBJ_FLAG_HIDDEN);
+
+	//电流趋势线，画在占比条上方、文字下方
+	const lv_coord_t border = lv_obj_get_style_border_width(panel, LV_PART_MAIN);
+	trend = sparkline_create(panel);
+	lv_obj_set_size(trend, lv_obj_get_style_width(panel, LV_PART_MAIN) - 2 * border, TREND_HEIGHT);
+	lv_obj_align(trend, LV_ALIGN_BOTTOM_MID, 0, lv_obj_get_style_pad_bottom(panel, LV_PART_MAIN) - border);
+	sparkline_set_range(trend, 0, static_cast<int32_t>(max_current));
+	sparkline_set_decimation(trend, TREND_DECIMATION);
+	sparkline_set_line_color(trend, lv_color_mix(lv_color_black(),
+		lv_obj_get_style_bg_color(panel, LV_PART_MAIN), LV_OPA_60));
+
+	//用定宽数字读数控件代替recolor label，数值变化时只重绘变化的那几格
+	readout = digit_readout_create(panel);
+	lv_obj_set_align(readout, lv_obj_get_style_align(label, LV_PART_MAIN));
+	lv_obj_set_pos(readout, lv_obj_get_x_aligned(label), lv_obj_get_y_aligned(label));
+	lv_obj_set_style_text_font(readout, lv_obj_get_style_text_font(label, LV_PART_MAIN), LV_PART_MAIN);
+	digit_readout_set_text(readout, 0, READOUT_TEMPLATE, act_lv_color);
+	lv_obj_add_flag(label, LV_OBJ_FLAG_HIDDEN);
+
+#if DIGIT_READOUT_USE_ATLAS
+	//有效数字和前导0在panel背景上各预混合一组数字贴图（42px字体每组约10KB），颜色组满了或内存不够时照常逐像素混合
+	const lv_font_t *font = lv_obj_get_style_text_font(readout, LV_PART_MAIN);
+	const lv_color_t panel_bg = lv_obj_get_style_bg_color(panel, LV_PART_MAIN);
+	digit_readout_atlas_add(font, act_lv_color, panel_bg);
+	digit_readout_atlas_add(font, non_act_lv_color, panel_bg);
+#endif
+
+	//动画回调通过panel的user_data找回对应的info_label
+	lv_obj_set_user_data(panel, this);
 }
 
 /**
@@ -66,65 +113,91 @@ void info_label::ina219_get_volt_cur_power(float *volt_v, float *cur_mA, float *
 
 /**
  * @brief 设置panel是否使能，失能则消失
+ * 动画进行中收到的请求只记录目标状态，等动画结束后再执行
  * @param enabled 是否使能
  */
 void info_label::set_enable(const bool enabled) {
-    if (panel_is_enabled() == enabled)
-        return;
+	target_enabled = enabled;
+	if (state == panel_state::enabling || state == panel_state::disabling)
+		return;
 
-	if (enabled) {
-//		lv_obj_clear_flag(panel, LV_OBJ_FLAG_HIDDEN);
-		 plenable_Animation(panel, 0);
-	} else {
-//		lv_obj_add_flag(panel, LV_OBJ_FLAG_HIDDEN);
-		 pldisable_Animation(panel, 0);
-	}
+	start_panel_transition();
 }
 
 /**
- * @brief 将电流和功率数据格式化成lvgl recolor风格化的字符串
- * @return 返回格式化后的字符串
+ * @brief 当前稳定状态和目标状态不一致时，启动对应的滑入/滑出动画
  */
-std::string info_label::fmt_info_str() const {
+void info_label::start_panel_transition() {
+	lv_anim_t *a;
+	if (target_enabled && state == panel_state::disabled) {
+		a = plenable_Animation(panel, 0);
+		state = panel_state::enabling;
+	} else if (!target_enabled && state == panel_state::enabled) {
+		a = pldisable_Animation(panel, 0);
+		state = panel_state::disabling;
+	} else {
+		return;
+	}
+
 	/*
-	电流mA最大四位数 功率mW最大四位数 格式
-	0000mA 0015mW，前导0为灰色
-	#A09896 00#  #F33C0D 00mA# 0015mW，前导0为灰色
-	*/
-	int dig_count = get_digit_count(static_cast<int>(current_ma));
-	std::ostringstream oss_ma;
-	oss_ma << std::setw(4) << std::setfill('0') << static_cast<int>(current_ma) << "mA#";	//先格式化出来不带颜色的
-	std::string str_ma = oss_ma.str();
-	str_ma.insert(4 - dig_count, "##" + active_color + " ");
-	str_ma.insert(0, "#" + non_act_color + " ");
-
-	dig_count = get_digit_count(static_cast<int>(power_mw));
-	std::ostringstream oss_mw;
-	oss_mw << std::setw(4) << std::setfill('0') << static_cast<int>(power_mw) << "mW#";	//先格式化出来不带颜色的
-	std::string str_mw = oss_mw.str();
-	str_mw.insert(4 - dig_count, "##" + active_color + " ");
-	str_mw.insert(0, "#" + non_act_color + " ");
-
-	return str_ma + " " + str_mw;
+	 * plenable/pldisable返回最后启动的那个动画（透明度），它和位移动画时长、延时相同，
+	 * 用它的回调代表整个过渡结束；deleted回调原本用来释放user_data，这里包一层
+	 */
+	panel_anim = a;
+	if (a) {
+		a->ready_cb = panel_anim_ready_cb;
+		a->deleted_cb = panel_anim_deleted_cb;
+	} else {
+		on_panel_anim_end(nullptr, false);
+	}
 }
 
 /**
- * @brief 计算一个十进制整数的位数
- * @param num 整数
- * @return 位数
+ * @brief panel动画结束
+ * @param a 结束的动画
+ * @param finished true: 正常播放完毕, false: 中途被删除，状态退回动画开始前
  */
-int info_label::get_digit_count(const int num) {
-	if (num == 0) return 1; // 0 有 1 位数字
-	const int abs_num = std::abs(num);
-	return static_cast<int>(std::log10(static_cast<double>(abs_num))) + 1;
+void info_label::on_panel_anim_end(lv_anim_t *a, const bool finished) {
+	if (a != panel_anim)
+		return;
+	panel_anim = nullptr;
+
+	if (state == panel_state::enabling) {
+		state = finished ? panel_state::enabled : panel_state::disabled;
+	} else if (state == panel_state::disabling) {
+		state = finished ? panel_state::disabled : panel_state::enabled;
+	}
+
+	start_panel_transition();
+}
+
+info_label *info_label::panel_owner(const lv_anim_t *a) {
+	const auto *usr = static_cast<const ui_anim_user_data_t *>(a->user_data);
+	if (usr == nullptr)
+		return nullptr;
+	return static_cast<info_label *>(lv_obj_get_user_data(usr->target));
+}
+
+void info_label::panel_anim_ready_cb(lv_anim_t *a) {
+	if (info_label *self = panel_owner(a))
+		self->on_panel_anim_end(a, true);
+}
+
+void info_label::panel_anim_deleted_cb(lv_anim_t *a) {
+	//正常结束时ready回调已经处理过，panel_anim不再等于a，这里只负责释放
+	if (info_label *self = panel_owner(a))
+		self->on_panel_anim_end(a, false);
+	_ui_anim_callback_free_user_data(a);
 }
 
 /**
- * @brief 设置label的字符串
- * @param str 要设置的字符串
+ * @brief 将电流和功率数据写入读数控件，前导0为灰色
  */
-void info_label::set_label_text(const std::string& str) const {
-	lv_label_set_text(label, str.c_str());
+void info_label::update_readout() const {
+	digit_readout_set_number(readout, READOUT_MA_START, READOUT_DIGITS, static_cast<uint32_t>(current_ma),
+		act_lv_color, non_act_lv_color);
+	digit_readout_set_number(readout, READOUT_MW_START, READOUT_DIGITS, static_cast<uint32_t>(power_mw),
+		act_lv_color, non_act_lv_color);
 }
 
 /**
@@ -139,37 +212,26 @@ bool info_label::check_voltage() const {
 }
 
 /**
- * @brief 设置label遮罩层在整个panel中的显示占比
+ * @brief 设置功率占比条在整个panel中的显示占比
+ * 占比条动画进行中时会直接改变动画的目标值，不会重新创建动画
  * @param pos_percent 百分比，范围0.0 ~ 1.0
- * @param pos_before 此次更新之前的位置，用于形成动画
  */
-void info_label::set_label_mask_pos(const float pos_percent, const float pos_before) {
-    //lv_obj_set_x(label_mask, static_cast<short>(map(pos_percent, 0, 1, GRAY_MASK_BEG, GARY_MASK_END)));
-    lv_anim_set_values(&anim, static_cast<short>(map(pos_before, 0, 1, GRAY_MASK_BEG, GARY_MASK_END)),
-                       static_cast<short>(map(pos_percent, 0, 1, GRAY_MASK_BEG, GARY_MASK_END)));
-    lv_anim_start(&anim);
+void info_label::set_label_mask_pos(const float pos_percent) {
+	power_gauge_set_value(gauge, static_cast<int32_t>(map(pos_percent, 0, 1, 0, POWER_GAUGE_RANGE)), LV_ANIM_ON);
 }
 
 void info_label::update_label_mask() {
-	set_label_mask_pos(current_ma / max_current, mask_pos_old);
-    mask_pos_old = current_ma / max_current;
+	set_label_mask_pos(current_ma / max_current);
+}
+
+/**
+ * @brief 把当前电流加入趋势线
+ */
+void info_label::update_trend() const {
+	sparkline_add_sample(trend, static_cast<int32_t>(current_ma));
 }
 
 float info_label::map(float val, const float old_min, const float old_max, const float new_min, const float new_max) {
 	val = std::clamp(val, old_min, old_max);
 	return (new_max - new_min) * (val - old_min) / (old_max - old_min) + new_min;
 }
-
-bool info_label::panel_is_enabled() const {
-    lv_obj_update_layout(panel);
-    uint32_t x = lv_obj_get_x(panel);
-    if (x >= panel_pos_threshold)
-    {
-        return false;
-    }
-    return true;
-}
-
-void anim_mask_cb(void * var, int32_t v) {
-    lv_obj_set_x((lv_obj_t *)var, v);
-}
@@ -8,25 +8,35 @@
 #include "lvgl.h"
 #include "INA219.h"
 
-#define GRAY_MASK_LEFT	(-168)
-#define GRAY_MASK_RIGHT	(168)
-#define GRAY_MASK_MID	(0)
-
-#define GRAY_MASK_BEG	GRAY_MASK_LEFT
-#define GARY_MASK_END	GRAY_MASK_MID
-
 class info_label
 {
+	/*
+	 * panel的使能状态，由plenable/pldisable动画的ready/deleted回调推进，
+	 * 不再通过强制刷新布局读取panel坐标来猜测动画是否结束
+	 */
+	enum class panel_state {
+		enabled,
+		enabling,
+		disabled,
+		disabling,
+	};
+
 	float max_current{};
-    float mask_pos_old{};
-    lv_anim_t anim{};       // 动画对象
     const uint32_t duration = 490;
-    const uint32_t panel_pos_threshold = 150;
+    panel_state state = panel_state::enabled;
+    bool target_enabled = true;
+    lv_anim_t *panel_anim = nullptr;	// 正在运行的panel动画，用于区分回调属于哪一次动画
+
+	lv_color_t act_lv_color{};
+	lv_color_t non_act_lv_color{};
 
 	void ina219_get_volt_cur_power(float *volt_v, float *cur_mA, float *power_mW) const;
-	static int get_digit_count(int num);
 	static float map(float val, float old_min, float old_max, float new_min, float new_max);
-    bool panel_is_enabled() const;
+    void start_panel_transition();
+    void on_panel_anim_end(lv_anim_t *a, bool finished);
+    static info_label *panel_owner(const lv_anim_t *a);
+    static void panel_anim_ready_cb(lv_anim_t *a);
+    static void panel_anim_deleted_cb(lv_anim_t *a);
 public:
 	float voltage_v{};
 	float current_ma{};
@@ -34,7 +44,10 @@ public:
 	INA219_t *ina219;
 	lv_obj_t *panel;
 	lv_obj_t *label;
+	lv_obj_t *readout;
 	lv_obj_t *label_mask;
+	lv_obj_t *gauge;
+	lv_obj_t *trend;
 	std::string active_color;
 	std::string non_act_color;
 	float threshold_voltage{};
@@ -44,11 +57,11 @@ public:
 	~info_label();
 
 	void set_enable(bool enabled);
-	[[nodiscard]] std::string fmt_info_str() const;
 	void refresh_sensor_data();
-	void set_label_text(const std::string& str) const;
-    void set_label_mask_pos(float pos_percent, float pos_before) ;
+	void update_readout() const;
+    void set_label_mask_pos(float pos_percent);
 	void update_label_mask();
+	void update_trend() const;
 	[[nodiscard]] bool check_voltage() const;
 };
 
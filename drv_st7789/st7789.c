@@ -8,11 +8,66 @@ extern "C" {
 #endif
 
 
+#if ST7789_BUS_BPP == 12
+#define BUS_COLOR(c)	ST7789_RGB444(c)
+#elif ST7789_BUS_BPP == 16
+#define BUS_COLOR(c)	(c)
+#else
+#error "ST7789_BUS_BPP must be 12 or 16"
+#endif
+
 #ifdef USE_DMA
 #include <string.h>
 #include <hardware/dma.h>
+#include <hardware/sync.h>
 uint DmaChann;
 dma_channel_config DmaCfg;
+
+/*
+ * 图像数据的DMA传输宽度：16位总线按字节发送（数据本身已经是高字节在前），
+ * 12位总线每个像素一个uint16_t，对应一个12位SPI帧
+ */
+#if ST7789_BUS_BPP == 12
+#define IMAGE_DMA_SIZE	DMA_SIZE_16
+#else
+#define IMAGE_DMA_SIZE	DMA_SIZE_8
+#endif
+
+/*
+ * 图像传输队列：一次传输 = 设置窗口(CASET/RASET/RAMWR) + 像素数据，
+ * 窗口命令只有十几个字节，直接用阻塞SPI写；像素数据交给DMA，
+ * 开始发送时调用DMA_START_CB；DMA完成中断里释放CS、通知DMA_FINISH_CB，并启动队列里的下一次传输
+ */
+typedef struct {
+	uint8_t caset[4];
+	uint8_t raset[4];
+	const uint8_t *data;
+	uint32_t len;			//每行的字节数 * rows
+	uint32_t stride;		//相邻两行起点的字节距离，等于每行字节数时数据是连续的
+	uint16_t rows;
+	uint32_t cpu_us;		//这次传输在驱动里花费的CPU时间
+} ST7789_Xfer;
+
+/*
+ * 跨步传输的控制块：控制通道把{count, read_addr}依次写进数据通道的
+ * AL3_TRANS_COUNT和AL3_READ_ADDR_TRIG，每写一块就触发数据通道发送一行，
+ * 数据通道发完又链式触发控制通道，最后一块{0, 0}是空触发，产生一次中断
+ */
+typedef struct {
+	uintptr_t count;
+	uintptr_t read_addr;
+} ST7789_DmaBlock;
+
+static ST7789_DmaBlock dma_blocks[ST7789_HEIGHT + 1] __attribute__((aligned(sizeof(ST7789_DmaBlock))));
+static int DmaCtrlChann = -1;
+
+static ST7789_Xfer xfer_queue[ST7789_QUEUE_LEN];
+static volatile uint8_t xfer_head;		//正在发送（或下一个要发送）的传输
+static volatile uint8_t xfer_tail;		//下一个空位
+static volatile bool xfer_active;		//DMA正在发送xfer_head的像素数据
+static ST7789_QueueStats queue_stats;
+
+static void ST7789_DmaIrqHandler(void);
 #endif
 
 
@@ -20,16 +75,27 @@ void HAL_Delay(uint16_t ms);
 
 static void ST7789_UnSelect() {
 #ifndef CFG_NO_CS
-
-#ifdef USE_DMA
-	if (!dma_channel_is_busy(DmaChann)) {
+	gpio_put(ST7789_CS_PIN, 1);
 #endif
-		gpio_put(ST7789_CS_PIN, 1);
+}
+
+/**
+ * @brief 等待传输队列清空、上一次DMA传输真正发送完毕
+ * DMA完成只代表数据都写进了SPI FIFO，FIFO里剩下的字节移出之前不能切换DC。
+ * 所有阻塞的命令/数据写入前都先调用这里，所以不能在DMA_FINISH_CB里调用阻塞接口
+ */
+static void ST7789_WaitBusIdle() {
 #ifdef USE_DMA
+	while (xfer_active || xfer_head != xfer_tail) {
+		tight_loop_contents();
+	}
+	if (dma_channel_is_claimed(DmaChann)) {
+		dma_channel_wait_for_finish_blocking(DmaChann);
 	}
 #endif
-
-#endif
+	while (spi_is_busy(ST7789_SPI_PORT)) {
+		tight_loop_contents();
+	}
 }
 
 static void ST7789_Select() {
@@ -45,6 +111,7 @@ static void ST7789_Select() {
  */
 static void ST7789_WriteCommand(uint8_t cmd)
 {
+	ST7789_WaitBusIdle();
 	ST7789_Select();
 	ST7789_DC_Clr();
 	//HAL_SPI_Transmit(&ST7789_SPI_PORT, &cmd, sizeof(cmd), HAL_MAX_DELAY);
@@ -60,19 +127,10 @@ static void ST7789_WriteCommand(uint8_t cmd)
  */
 static void ST7789_WriteData(uint8_t *buff, size_t buff_size)
 {
+	//大块像素数据走ST7789_QueueImage，这里只写命令参数等少量数据，直接阻塞发送
 	ST7789_Select();
 	ST7789_DC_Set();
-#ifdef USE_DMA
-	if (dma_channel_is_claimed(DmaChann)) {
-		dma_channel_set_read_addr(DmaChann, buff, false); //设置读地址但是不启动传输
-		dma_channel_set_trans_count(DmaChann, buff_size, true); //设置传输数据长度并且开始传输
-	}
-	else {	//DMA 通道还没有获得，即初始化时不用DMA SPI
-		spi_write_blocking(ST7789_SPI_PORT, buff, buff_size);
-	}
-#else
 	spi_write_blocking(ST7789_SPI_PORT, buff, buff_size);
-#endif //USE_DMA
 	ST7789_UnSelect();
 }
 
@@ -98,6 +156,64 @@ static void ST7789_WriteSmallData(uint8_t data)
 	ST7789_UnSelect();
 }
 
+/**
+ * @brief 向当前窗口连续写入px个相同颜色的像素
+ * SPI临时切换为16位帧，高字节先发；DMA以16位宽、读地址不自增的方式反复读取同一个颜色值，
+ * 单次传输不超过ST7789_FILL_CHUNK_PX个像素。填充是阻塞完成的，期间关闭通知LVGL的完成中断。
+ * DMA通道还没有获得时（初始化阶段）用一行缓冲分段写
+ * @param color -> RGB565 color
+ * @param px -> number of pixels
+ * @return none
+ */
+static void ST7789_WriteColorRepeat(uint16_t color, uint32_t px)
+{
+	ST7789_Select();
+	ST7789_DC_Set();
+	spi_set_format(ST7789_SPI_PORT, ST7789_BUS_BPP, SPI_CPOL_1, SPI_CPHA_1, SPI_MSB_FIRST);
+	color = BUS_COLOR(color);
+
+#ifdef USE_DMA
+	if (dma_channel_is_claimed(DmaChann)) {
+		static uint16_t fill_color;		//DMA传输期间必须一直有效
+		fill_color = color;
+
+		dma_channel_config cfg = DmaCfg;
+		channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+		channel_config_set_read_increment(&cfg, false);
+		channel_config_set_bswap(&cfg, false);
+
+		dma_channel_set_irq0_enabled(DmaChann, false);
+		dma_channel_set_config(DmaChann, &cfg, false);
+		dma_channel_set_read_addr(DmaChann, &fill_color, false);
+		while (px) {
+			uint32_t n = px < ST7789_FILL_CHUNK_PX ? px : ST7789_FILL_CHUNK_PX;
+			dma_channel_set_trans_count(DmaChann, n, true);
+			dma_channel_wait_for_finish_blocking(DmaChann);
+			px -= n;
+		}
+		dma_channel_set_config(DmaChann, &DmaCfg, false);
+		dma_channel_acknowledge_irq0(DmaChann);
+		dma_channel_set_irq0_enabled(DmaChann, true);
+	}
+	else
+#endif //USE_DMA
+	{
+		uint16_t line[ST7789_WIDTH];
+		for (uint16_t i = 0; i < ST7789_WIDTH; i++) line[i] = color;
+		while (px) {
+			uint32_t n = px < ST7789_WIDTH ? px : ST7789_WIDTH;
+			spi_write16_blocking(ST7789_SPI_PORT, line, n);
+			px -= n;
+		}
+	}
+
+	while (spi_is_busy(ST7789_SPI_PORT)) {
+		tight_loop_contents();
+	}
+	spi_set_format(ST7789_SPI_PORT, 8, SPI_CPOL_1, SPI_CPHA_1, SPI_MSB_FIRST);
+	ST7789_UnSelect();
+}
+
 /**
  * @brief Set the rotation direction of the display
  * @param m -> rotation parameter(please refer it in st7789.h)
@@ -124,6 +240,82 @@ void ST7789_SetRotation(uint8_t m)
 	}
 }
 
+#ifdef ST7789_SCROLL_ALONG_X
+#define SCROLL_SHIFT	X_SHIFT
+#else
+#define SCROLL_SHIFT	Y_SHIFT
+#endif
+
+/* MADCTL.MY把行地址倒过来映射到门线上，滚动区域和方向都要跟着翻转 */
+#if ST7789_ROTATION == 0 || ST7789_ROTATION == 1
+#define SCROLL_MIRRORED	1
+#else
+#define SCROLL_MIRRORED	0
+#endif
+
+static uint16_t scroll_first;		//滚动区域的第一条门线(TFA)
+static uint16_t scroll_len = ST7789_GATE_LINES;
+
+/**
+ * @brief 设置硬件滚动区域，区域外的部分固定不动
+ * @param start&len -> area along the scroll axis (screen X for rotation 1/3, screen Y for 0/2)
+ * @return none
+ */
+void ST7789_SetScrollArea(uint16_t start, uint16_t len)
+{
+	uint16_t first = start + SCROLL_SHIFT;
+#if SCROLL_MIRRORED
+	first = ST7789_GATE_LINES - (first + len);
+#endif
+	uint16_t bfa = ST7789_GATE_LINES - first - len;
+
+	ST7789_WriteCommand(ST7789_VSCRDEF);
+	{
+		uint8_t data[] = {first >> 8, first & 0xFF, len >> 8, len & 0xFF, bfa >> 8, bfa & 0xFF};
+		ST7789_WriteData(data, sizeof(data));
+	}
+	scroll_first = first;
+	scroll_len = len;
+	ST7789_SetScrollOffset(0);
+}
+
+/**
+ * @brief 设置滚动量：滚动区域内第start+i个位置显示显存里第start+(i+offset)%len个位置的内容，
+ * 也就是整个区域的内容朝start方向移动offset，移出去的部分从另一端回绕进来
+ * 显存内容和写入地址都不受影响
+ * @param offset -> lines to move towards start
+ * @return none
+ */
+void ST7789_SetScrollOffset(uint16_t offset)
+{
+	offset %= scroll_len;
+#if SCROLL_MIRRORED
+	offset = (scroll_len - offset) % scroll_len;
+#endif
+	uint16_t vsp = scroll_first + offset;
+
+	ST7789_WriteCommand(ST7789_VSCSAD);
+	{
+		uint8_t data[] = {vsp >> 8, vsp & 0xFF};
+		ST7789_WriteData(data, sizeof(data));
+	}
+}
+
+/**
+ * @brief 取消滚动，整个显存按写入的位置显示
+ */
+void ST7789_ResetScroll(void)
+{
+	ST7789_WriteCommand(ST7789_VSCRDEF);
+	{
+		uint8_t data[] = {0, 0, ST7789_GATE_LINES >> 8, ST7789_GATE_LINES & 0xFF, 0, 0};
+		ST7789_WriteData(data, sizeof(data));
+	}
+	scroll_first = 0;
+	scroll_len = ST7789_GATE_LINES;
+	ST7789_SetScrollOffset(0);
+}
+
 /**
  * @brief Set address of DisplayWindow
  * @param xi&yi -> coordinates of window
@@ -131,6 +323,7 @@ void ST7789_SetRotation(uint8_t m)
  */
 static void ST7789_SetAddressWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
 {
+	ST7789_WaitBusIdle();
 	ST7789_Select();
 	uint16_t x_start = x0 + X_SHIFT, x_end = x1 + X_SHIFT;
 	uint16_t y_start = y0 + Y_SHIFT, y_end = y1 + Y_SHIFT;
@@ -179,10 +372,15 @@ void ST7789_Init(void)
 
 #ifdef USE_DMA
 	DmaCfg = dma_channel_get_default_config(DmaChann);
-	channel_config_set_transfer_data_size(&DmaCfg, DMA_SIZE_8);
+	channel_config_set_transfer_data_size(&DmaCfg, IMAGE_DMA_SIZE);
 	channel_config_set_dreq(&DmaCfg, spi_get_dreq(ST7789_SPI_PORT, true));
 	channel_config_set_read_increment(&DmaCfg, true);
+#if ST7789_BUS_BPP == 12
+	//ST7789_ConvertRGB444转换后每个uint16_t就是一个12位帧的值，不能再交换字节
+	channel_config_set_bswap(&DmaCfg, false);
+#else
 	channel_config_set_bswap(&DmaCfg, true);
+#endif
 	dma_channel_cleanup(DmaChann);
 	dma_channel_configure(DmaChann,
 						  &DmaCfg,
@@ -199,7 +397,11 @@ void ST7789_Init(void)
     HAL_Delay(50);
 		
     ST7789_WriteCommand(ST7789_COLMOD);		//	Set color mode
+#if ST7789_BUS_BPP == 12
+    ST7789_WriteSmallData(ST7789_COLOR_MODE_12bit);
+#else
     ST7789_WriteSmallData(ST7789_COLOR_MODE_16bit);
+#endif
   	ST7789_WriteCommand(0xB2);				//	Porch control
 	{
 		uint8_t data[] = {0x0C, 0x0C, 0x00, 0x33, 0x33};
@@ -244,12 +446,12 @@ void ST7789_Init(void)
   	ST7789_WriteCommand (ST7789_DISPON);	//	Main screen turned on	
 
 	// HAL_Delay(50);
-	// ST7789_Fill_Color(WHITE);				//	Fill with Black.
+	ST7789_Fill_Color(BLACK);				//	Fill with Black.
 
 #ifdef USE_DMA
 	//初始化完成之后，使能DMA完成中断，在中断里面通知LVGL屏幕刷新准备好了
 	dma_channel_set_irq0_enabled(DmaChann, true);
-	irq_set_exclusive_handler(DMA_IRQ_0, DMA_FINISH_CB);
+	irq_set_exclusive_handler(DMA_IRQ_0, ST7789_DmaIrqHandler);
 	irq_set_enabled(DMA_IRQ_0, true);
 
 	dma_channel_start(DmaChann);
@@ -265,17 +467,8 @@ void ST7789_Init(void)
  */
 void ST7789_Fill_Color(uint16_t color)
 {
-	uint16_t i = 0;
 	ST7789_SetAddressWindow(0, 0, ST7789_WIDTH - 1, ST7789_HEIGHT - 1);
-	ST7789_Select();
-
-	uint16_t j;
-	for (i = 0; i < ST7789_WIDTH; i++)
-			for (j = 0; j < ST7789_HEIGHT; j++) {
-				uint8_t data[] = {color >> 8, color & 0xFF};
-				ST7789_WriteData(data, sizeof(data));
-			}
-	ST7789_UnSelect();
+	ST7789_WriteColorRepeat(color, (uint32_t)ST7789_WIDTH * ST7789_HEIGHT);
 }
 
 /**
@@ -290,10 +483,14 @@ void ST7789_DrawPixel(uint16_t x, uint16_t y, uint16_t color)
 		 (y < 0) || (y >= ST7789_HEIGHT))	return;
 	
 	ST7789_SetAddressWindow(x, y, x, y);
+#if ST7789_BUS_BPP == 12
+	ST7789_WriteColorRepeat(color, 1);
+#else
 	uint8_t data[] = {color >> 8, color & 0xFF};
 	ST7789_Select();
 	ST7789_WriteData(data, sizeof(data));
 	ST7789_UnSelect();
+#endif
 }
 
 /**
@@ -307,19 +504,14 @@ void ST7789_Fill(uint16_t xSta, uint16_t ySta, uint16_t xEnd, uint16_t yEnd, uin
 {
 	if ((xEnd < 0) || (xEnd >= ST7789_WIDTH) ||
 		 (yEnd < 0) || (yEnd >= ST7789_HEIGHT))	return;
-	ST7789_Select();
-	uint16_t i, j;
+	if ((xSta > xEnd) || (ySta > yEnd)) return;
+
 	ST7789_SetAddressWindow(xSta, ySta, xEnd, yEnd);
-	for (i = ySta; i <= yEnd; i++)
-		for (j = xSta; j <= xEnd; j++) {
-			uint8_t data[] = {color >> 8, color & 0xFF};
-			ST7789_WriteData(data, sizeof(data));
-		}
-	ST7789_UnSelect();
+	ST7789_WriteColorRepeat(color, (uint32_t)(xEnd - xSta + 1) * (yEnd - ySta + 1));
 }
 
 /**
- * @brief Draw an Image on the screen
+ * @brief Draw an Image on the screen, the part outside the screen is clipped
  * @param x&y -> start point of the Image
  * @param w&h -> width & height of the Image to Draw
  * @param data -> pointer of the Image array
@@ -327,19 +519,426 @@ void ST7789_Fill(uint16_t xSta, uint16_t ySta, uint16_t xEnd, uint16_t yEnd, uin
  */
 void ST7789_DrawImage(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *data)
 {
-	if ((x >= ST7789_WIDTH) || (y >= ST7789_HEIGHT))
-		return;
-	if ((x + w - 1) >= ST7789_WIDTH)
-		return;
-	if ((y + h - 1) >= ST7789_HEIGHT)
+	ST7789_DrawImageStrided(x, y, w, h, data, w);
+}
+
+/**
+ * @brief 从更大的源图像（整屏缓冲、图集等）里画出一块：行在内存中相隔stride个像素，
+ * 超出屏幕的部分被裁掉，起点可以是负数；像素直接从源图像发送，不复制到中间缓冲
+ * 有DMA时加入传输队列就返回，之前data必须保持有效
+ * @param x&y -> start point of the Image, may be negative
+ * @param w&h -> width & height of the Image to Draw
+ * @param data -> pixel of the Image at (x, y)
+ * @param stride -> pixels between the starts of two rows in data, >= w
+ * @return none
+ */
+void ST7789_DrawImageStrided(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t *data, uint16_t stride)
+{
+	int32_t x1 = x < 0 ? 0 : x, y1 = y < 0 ? 0 : y;
+	int32_t x2 = (int32_t)x + w, y2 = (int32_t)y + h;
+	if (x2 > ST7789_WIDTH) x2 = ST7789_WIDTH;
+	if (y2 > ST7789_HEIGHT) y2 = ST7789_HEIGHT;
+	if (x1 >= x2 || y1 >= y2) return;
+
+	data += (y1 - y) * stride + (x1 - x);
+	w = (uint16_t)(x2 - x1);
+	h = (uint16_t)(y2 - y1);
+
+#ifdef USE_DMA
+	if (dma_channel_is_claimed(DmaChann)) {
+		ST7789_QueueImageStrided((uint16_t)x1, (uint16_t)y1, w, h, data, stride);
 		return;
+	}
+#endif
 
+	ST7789_SetAddressWindow((uint16_t)x1, (uint16_t)y1, (uint16_t)(x2 - 1), (uint16_t)(y2 - 1));
 	ST7789_Select();
+	ST7789_DC_Set();
+#if ST7789_BUS_BPP == 12
+	spi_set_format(ST7789_SPI_PORT, 12, SPI_CPOL_1, SPI_CPHA_1, SPI_MSB_FIRST);
+#endif
+	//连续的图像一次写完，否则逐行从源图像发送
+	uint32_t row_px = w;
+	if (stride == w) {
+		row_px *= h;
+		h = 1;
+	}
+	for (uint16_t i = 0; i < h; i++, data += stride) {
+#if ST7789_BUS_BPP == 12
+		spi_write16_blocking(ST7789_SPI_PORT, data, row_px);
+#else
+		spi_write_blocking(ST7789_SPI_PORT, (const uint8_t *)data, sizeof(uint16_t) * row_px);
+#endif
+	}
+#if ST7789_BUS_BPP == 12
+	spi_set_format(ST7789_SPI_PORT, 8, SPI_CPOL_1, SPI_CPHA_1, SPI_MSB_FIRST);
+#endif
+	ST7789_UnSelect();
+}
+
+/**
+ * @brief 把一行文字的第row行像素展开成总线格式的颜色，字模每行是一个uint16_t，最高位是最左边的像素
+ * 字体里只有' '到'~'，其他字符画成'?'
+ */
+static void ST7789_ExpandTextRow(uint16_t *buf, const char *str, uint16_t n, const FontDef *font, uint16_t row,
+								 uint16_t color, uint16_t bgcolor)
+{
+	for (uint16_t i = 0; i < n; i++) {
+		uint8_t ch = (uint8_t)str[i];
+		if (ch < ' ' || ch > '~') ch = '?';
+		uint16_t bits = font->data[(ch - ' ') * font->height + row];
+		for (uint8_t j = 0; j < font->width; j++, bits <<= 1) {
+			*buf++ = (bits & 0x8000) ? color : bgcolor;
+		}
+	}
+}
+
+/**
+ * @brief 画一行文字，调用方保证这一行在水平方向放得下，底部超出屏幕的部分被裁掉
+ * 整行只设置一次窗口；每行像素展开到行缓冲后一次发送，有DMA时两块行缓冲交替使用，
+ * DMA发送这一行的同时CPU展开下一行。阻塞到发送完毕，不经过传输队列，也不调用DMA_START_CB/DMA_FINISH_CB
+ */
+static void ST7789_WriteTextLine(uint16_t x, uint16_t y, const char *str, uint16_t n, const FontDef *font,
+								 uint16_t color, uint16_t bgcolor)
+{
+	static uint16_t rows[2][ST7789_WIDTH];
+	uint16_t w = n * font->width;
+	uint16_t h = font->height;
+	if (y + h > ST7789_HEIGHT) h = ST7789_HEIGHT - y;
+	color = BUS_COLOR(color);
+	bgcolor = BUS_COLOR(bgcolor);
+
 	ST7789_SetAddressWindow(x, y, x + w - 1, y + h - 1);
-	ST7789_WriteData((uint8_t *)data, sizeof(uint16_t) * w * h);
+	ST7789_Select();
+	ST7789_DC_Set();
+	spi_set_format(ST7789_SPI_PORT, ST7789_BUS_BPP, SPI_CPOL_1, SPI_CPHA_1, SPI_MSB_FIRST);
+	ST7789_ExpandTextRow(rows[0], str, n, font, 0, color, bgcolor);
+
+#ifdef USE_DMA
+	if (dma_channel_is_claimed(DmaChann)) {
+		//和填充一样按16位宽发送，行缓冲里就是原样的颜色值，不需要交换字节
+		dma_channel_config cfg = DmaCfg;
+		channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+		channel_config_set_bswap(&cfg, false);
+
+		dma_channel_set_irq0_enabled(DmaChann, false);
+		dma_channel_set_config(DmaChann, &cfg, false);
+		for (uint16_t row = 0; row < h; row++) {
+			dma_channel_set_read_addr(DmaChann, rows[row & 1], false);
+			dma_channel_set_trans_count(DmaChann, w, true);
+			if (row + 1 < h) {
+				ST7789_ExpandTextRow(rows[(row + 1) & 1], str, n, font, row + 1, color, bgcolor);
+			}
+			dma_channel_wait_for_finish_blocking(DmaChann);
+		}
+		dma_channel_set_config(DmaChann, &DmaCfg, false);
+		dma_channel_acknowledge_irq0(DmaChann);
+		dma_channel_set_irq0_enabled(DmaChann, true);
+	}
+	else
+#endif //USE_DMA
+	{
+		for (uint16_t row = 0; row < h; row++) {
+			if (row) ST7789_ExpandTextRow(rows[0], str, n, font, row, color, bgcolor);
+			spi_write16_blocking(ST7789_SPI_PORT, rows[0], w);
+		}
+	}
+
+	while (spi_is_busy(ST7789_SPI_PORT)) {
+		tight_loop_contents();
+	}
+	spi_set_format(ST7789_SPI_PORT, 8, SPI_CPOL_1, SPI_CPHA_1, SPI_MSB_FIRST);
 	ST7789_UnSelect();
 }
 
+/**
+ * @brief Write a char, nothing is drawn if it doesn't fit horizontally
+ * @param x&y -> cursor of the start point.
+ * @param ch -> char to write
+ * @param font -> fontstyle of the string
+ * @param color -> color of the char
+ * @param bgcolor -> background color of the char
+ * @return  none
+ */
+void ST7789_WriteChar(uint16_t x, uint16_t y, char ch, FontDef font, uint16_t color, uint16_t bgcolor)
+{
+	if (x + font.width > ST7789_WIDTH || y >= ST7789_HEIGHT) return;
+	ST7789_WriteTextLine(x, y, &ch, 1, &font, color, bgcolor);
+}
+
+/**
+ * @brief Write a string, wraps to x = 0 at the right edge and at '\n', stops at the bottom
+ * 每一行文字只设置一次窗口，每行像素一次传输
+ * @param x&y -> cursor of the start point.
+ * @param str -> string to write
+ * @param font -> fontstyle of the string
+ * @param color -> color of the string
+ * @param bgcolor -> background color of the string
+ * @return  none
+ */
+void ST7789_WriteString(uint16_t x, uint16_t y, const char *str, FontDef font, uint16_t color, uint16_t bgcolor)
+{
+	while (*str && y < ST7789_HEIGHT) {
+		uint16_t fit = x < ST7789_WIDTH ? (ST7789_WIDTH - x) / font.width : 0;
+		uint16_t n = 0;
+		while (str[n] && str[n] != '\n' && n < fit) n++;
+		if (n) ST7789_WriteTextLine(x, y, str, n, &font, color, bgcolor);
+
+		str += n;
+		if (*str == '\n') str++;
+		x = 0;
+		y += font.height;
+	}
+}
+
+#ifdef USE_DMA
+static uint8_t ST7789_QueueNext(uint8_t idx) {
+	return (uint8_t)((idx + 1) % ST7789_QUEUE_LEN);
+}
+
+/**
+ * @brief 写窗口命令并启动像素DMA，调用时必须屏蔽中断（或者就在DMA中断里）
+ */
+static void ST7789_StartXfer(ST7789_Xfer *xfer)
+{
+	static const uint8_t cmd_caset = ST7789_CASET;
+	static const uint8_t cmd_raset = ST7789_RASET;
+	static const uint8_t cmd_ramwr = ST7789_RAMWR;
+	DMA_START_CB();
+	uint32_t t0 = time_us_32();
+
+	ST7789_Select();
+	ST7789_DC_Clr();
+	spi_write_blocking(ST7789_SPI_PORT, &cmd_caset, 1);
+	ST7789_DC_Set();
+	spi_write_blocking(ST7789_SPI_PORT, xfer->caset, sizeof(xfer->caset));
+	ST7789_DC_Clr();
+	spi_write_blocking(ST7789_SPI_PORT, &cmd_raset, 1);
+	ST7789_DC_Set();
+	spi_write_blocking(ST7789_SPI_PORT, xfer->raset, sizeof(xfer->raset));
+	ST7789_DC_Clr();
+	spi_write_blocking(ST7789_SPI_PORT, &cmd_ramwr, 1);
+	ST7789_DC_Set();
+#if ST7789_BUS_BPP == 12
+	//spi_write_blocking返回时命令字节已经移出，可以切换帧宽，中断里再切回8位
+	spi_set_format(ST7789_SPI_PORT, 12, SPI_CPOL_1, SPI_CPHA_1, SPI_MSB_FIRST);
+#endif
+
+	xfer_active = true;
+	if (xfer->stride == xfer->len / xfer->rows) {
+		dma_channel_set_config(DmaChann, &DmaCfg, false);
+		xfer->cpu_us += time_us_32() - t0;
+		dma_channel_set_read_addr(DmaChann, xfer->data, false);
+		dma_channel_set_trans_count(DmaChann, xfer->len >> IMAGE_DMA_SIZE, true);
+		return;
+	}
+
+	//跨步的图像每行一个控制块，整块只在最后的空触发时进一次中断
+	uint32_t row_len = xfer->len / xfer->rows;
+	for (uint16_t i = 0; i < xfer->rows; i++) {
+		dma_blocks[i].count = row_len >> IMAGE_DMA_SIZE;
+		dma_blocks[i].read_addr = (uintptr_t)(xfer->data + i * xfer->stride);
+	}
+	dma_blocks[xfer->rows].count = 0;
+	dma_blocks[xfer->rows].read_addr = 0;
+	queue_stats.sram_bytes += sizeof(ST7789_DmaBlock) * (xfer->rows + 1);
+
+	dma_channel_config cfg = DmaCfg;
+	channel_config_set_chain_to(&cfg, DmaCtrlChann);
+	channel_config_set_irq_quiet(&cfg, true);
+	dma_channel_set_config(DmaChann, &cfg, false);
+	xfer->cpu_us += time_us_32() - t0;
+	dma_channel_set_read_addr(DmaCtrlChann, dma_blocks, true);
+}
+
+/**
+ * @brief 跨步传输第一次使用时申请控制通道，申请不到返回false
+ */
+static bool ST7789_ClaimCtrlChannel(void)
+{
+	if (DmaCtrlChann >= 0) return true;
+
+	int chann = dma_claim_unused_channel(false);
+	if (chann < 0) return false;
+
+	dma_channel_config cfg = dma_channel_get_default_config(chann);
+	channel_config_set_transfer_data_size(&cfg, DMA_SIZE_32);
+	channel_config_set_read_increment(&cfg, true);
+	channel_config_set_write_increment(&cfg, true);
+	//每次写两个寄存器后写地址回绕到AL3_TRANS_COUNT
+	channel_config_set_ring(&cfg, true, __builtin_ctz(sizeof(ST7789_DmaBlock)));
+	dma_channel_configure(chann, &cfg, &dma_hw->ch[DmaChann].al3_transfer_count, dma_blocks,
+						  sizeof(ST7789_DmaBlock) / sizeof(uintptr_t), false);
+	DmaCtrlChann = chann;
+	return true;
+}
+
+/**
+ * @brief 把一块图像加入传输队列，队列空闲时立即开始发送，然后直接返回
+ * 发送完毕后在中断里调用DMA_FINISH_CB，在此之前data必须保持有效
+ * 队列满时等待最早的一次传输完成
+ * @param x&y -> start point of the Image
+ * @param w&h -> width & height of the Image to Draw
+ * @param data -> pointer of the Image array
+ * @return none
+ */
+void ST7789_QueueImage(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *data)
+{
+	ST7789_QueueImageStrided(x, y, w, h, data, w);
+}
+
+/**
+ * @brief 同ST7789_QueueImage，但图像的行在内存中相隔stride个像素，
+ * 用于直接发送整屏缓冲中的一块区域；行之间由DMA控制块衔接，不经过CPU
+ * 申请不到控制通道时退化为每行一次传输
+ * @param stride -> pixels between the starts of two rows, >= w
+ * @return none
+ */
+void ST7789_QueueImageStrided(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *data, uint16_t stride)
+{
+	if (stride != w && h > 1 && !ST7789_ClaimCtrlChannel()) {
+		for (uint16_t i = 0; i < h; i++) {
+			ST7789_QueueImageStrided(x, y + i, w, 1, data + i * stride, w);
+		}
+		return;
+	}
+
+	uint32_t t0 = time_us_32();
+	while (ST7789_QueueNext(xfer_tail) == xfer_head) {
+		tight_loop_contents();
+	}
+
+	ST7789_Xfer *xfer = &xfer_queue[xfer_tail];
+	uint16_t x_start = x + X_SHIFT, x_end = x + w - 1 + X_SHIFT;
+	uint16_t y_start = y + Y_SHIFT, y_end = y + h - 1 + Y_SHIFT;
+	xfer->caset[0] = x_start >> 8;
+	xfer->caset[1] = x_start & 0xFF;
+	xfer->caset[2] = x_end >> 8;
+	xfer->caset[3] = x_end & 0xFF;
+	xfer->raset[0] = y_start >> 8;
+	xfer->raset[1] = y_start & 0xFF;
+	xfer->raset[2] = y_end >> 8;
+	xfer->raset[3] = y_end & 0xFF;
+	xfer->data = (const uint8_t *)data;
+	xfer->len = sizeof(uint16_t) * w * h;
+	xfer->stride = sizeof(uint16_t) * (h > 1 ? stride : w);
+	xfer->rows = h;
+
+	uint32_t irq_state = save_and_disable_interrupts();
+	bool idle = !xfer_active && xfer_head == xfer_tail;
+	xfer_tail = ST7789_QueueNext(xfer_tail);
+	xfer->cpu_us = time_us_32() - t0;
+	if (idle) {
+		ST7789_StartXfer(xfer);
+	}
+	restore_interrupts(irq_state);
+}
+
+/**
+ * @brief DMA完成中断：等SPI移完最后几个字节后释放CS，通知上层，再启动下一次传输
+ */
+static void ST7789_DmaIrqHandler(void)
+{
+	dma_channel_acknowledge_irq0(DmaChann);
+	if (!xfer_active) return;
+
+	uint32_t t0 = time_us_32();
+	while (spi_is_busy(ST7789_SPI_PORT)) {
+		tight_loop_contents();
+	}
+#if ST7789_BUS_BPP == 12
+	spi_set_format(ST7789_SPI_PORT, 8, SPI_CPOL_1, SPI_CPHA_1, SPI_MSB_FIRST);
+#endif
+	ST7789_UnSelect();
+
+	ST7789_Xfer *xfer = &xfer_queue[xfer_head];
+	xfer->cpu_us += time_us_32() - t0;
+	queue_stats.xfers++;
+	queue_stats.cpu_us_last = xfer->cpu_us;
+	queue_stats.cpu_us_total += xfer->cpu_us;
+	if (xfer->cpu_us > queue_stats.cpu_us_max) queue_stats.cpu_us_max = xfer->cpu_us;
+
+	xfer_active = false;
+	xfer_head = ST7789_QueueNext(xfer_head);
+
+	DMA_FINISH_CB();
+
+	if (xfer_head != xfer_tail) {
+		ST7789_StartXfer(&xfer_queue[xfer_head]);
+	}
+}
+
+/**
+ * @brief 获取传输队列的统计：完成的传输次数，以及每次传输在驱动里花费的CPU时间
+ * （入队 + 写窗口命令 + 完成中断，不包括DMA_FINISH_CB）
+ */
+void ST7789_GetQueueStats(ST7789_QueueStats *stats)
+{
+	uint32_t irq_state = save_and_disable_interrupts();
+	*stats = queue_stats;
+	restore_interrupts(irq_state);
+}
+#endif //USE_DMA
+
+/**
+ * @brief 停止正在发送的图像并丢弃传输队列，故障处理接管屏幕前调用，
+ * 这之后的阻塞绘图不会等待一个不会再来的DMA完成中断；被丢弃的图像不会调用DMA_FINISH_CB
+ */
+void ST7789_AbortQueue(void)
+{
+#ifdef USE_DMA
+	uint32_t irq_state = save_and_disable_interrupts();
+	if (dma_channel_is_claimed(DmaChann)) {
+		dma_channel_set_irq0_enabled(DmaChann, false);
+		if (DmaCtrlChann >= 0) dma_channel_abort(DmaCtrlChann);
+		dma_channel_abort(DmaChann);
+		dma_channel_set_config(DmaChann, &DmaCfg, false);
+		dma_channel_acknowledge_irq0(DmaChann);
+		dma_channel_set_irq0_enabled(DmaChann, true);
+	}
+	xfer_active = false;
+	xfer_head = xfer_tail;
+	restore_interrupts(irq_state);
+#endif
+	while (spi_is_busy(ST7789_SPI_PORT)) {
+		tight_loop_contents();
+	}
+	spi_set_format(ST7789_SPI_PORT, 8, SPI_CPOL_1, SPI_CPHA_1, SPI_MSB_FIRST);
+	ST7789_UnSelect();
+}
+
+/**
+ * @brief 把RGB565图像原地转换成12位总线使用的格式：每个uint16_t的低12位是一个RGB444像素
+ * 输入和16位总线下ST7789_DrawImage的输入一样是高字节在前的RGB565(LVGL的LV_COLOR_16_SWAP缓冲)，
+ * 直接从交换过的字节里取出各分量的高4位，不需要先把字节换回来；每次处理两个像素
+ * @param buf -> image, converted in place
+ * @param px -> number of pixels
+ * @return none
+ */
+void ST7789_ConvertRGB444(uint16_t *buf, uint32_t px)
+{
+	/*
+	 * 按小端读出的一个像素: bit 7..3 = R, bit 2..0 = G[5:3], bit 15..13 = G[2:0], bit 12..8 = B
+	 * RGB444: R[4:1] -> bit 11..8, G[5:2] -> bit 7..4, B[4:1] -> bit 3..0
+	 */
+	if (((uintptr_t)buf & 3) && px) {
+		uint16_t v = *buf;
+		*buf++ = ((v & 0xF0) << 4) | ((v & 0x07) << 5) | ((v >> 11) & 0x10) | ((v >> 9) & 0x0F);
+		px--;
+	}
+
+	uint32_t *w = (uint32_t *)buf;
+	for (uint32_t i = 0; i < px / 2; i++) {
+		uint32_t v = w[i];
+		w[i] = ((v & 0x00F000F0) << 4) | ((v & 0x00070007) << 5) | ((v >> 11) & 0x00100010) | ((v >> 9) & 0x000F000F);
+	}
+
+	if (px & 1) {
+		uint16_t v = buf[px - 1];
+		buf[px - 1] = ((v & 0xF0) << 4) | ((v & 0x07) << 5) | ((v >> 11) & 0x10) | ((v >> 9) & 0x0F);
+	}
+}
+
 void HAL_Delay(const uint16_t ms) {
 	sleep_ms(ms);
 }
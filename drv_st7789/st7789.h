@@ -18,13 +18,42 @@ extern "C" {
 
 #ifdef ENABLE_DMA_IRQ
 
+/* Called from the DMA IRQ after a queued image has been sent out completely and CS is released */
 #define DMA_FINISH_CB dma_handler
 
 extern void DMA_FINISH_CB();
+
+/* Called when a queued image starts to be sent (window commands + pixel DMA), with interrupts disabled or from the DMA IRQ */
+#define DMA_START_CB dma_start_handler
+
+extern void DMA_START_CB();
 extern uint DmaChann;
 
 #endif
 
+/* Depth of the image transfer queue used by ST7789_DrawImage/ST7789_QueueImage */
+#define ST7789_QUEUE_LEN		(4)
+
+typedef struct {
+	uint32_t xfers;				// queued images sent
+	uint32_t cpu_us_last;		// driver CPU time of the last image
+	uint32_t cpu_us_max;
+	uint32_t cpu_us_total;
+	uint32_t sram_bytes;		// bytes the driver wrote to SRAM to send images (DMA control blocks), pixels are never copied
+} ST7789_QueueStats;
+
+/*
+ * Pixel format on the bus: 16 -> RGB565, 12 -> RGB444 sent as 12-bit SPI frames (1.5 bytes/pixel).
+ * With 12, image data passed to ST7789_DrawImage/ST7789_QueueImage holds one RGB444 pixel
+ * in the low 12 bits of every uint16_t, see ST7789_ConvertRGB444. Colors are still given in RGB565.
+ */
+#ifndef ST7789_BUS_BPP
+#define ST7789_BUS_BPP 16
+#endif
+
+/* Max pixels per DMA transfer when filling an area with a single color */
+#define ST7789_FILL_CHUNK_PX	(0x8000)
+
 /* If u need CS control, comment below*/
 // #define CFG_NO_CS
 
@@ -70,6 +99,17 @@ extern uint DmaChann;
 //#define ST7789_ROTATION 2				//  use Normally on 240x240
 #define ST7789_ROTATION 3
 
+/* Gate lines of the frame memory, VSCRDEF's TFA + VSA + BFA must add up to this */
+#define ST7789_GATE_LINES 320
+
+/*
+ * Hardware scrolling always moves along the gate lines:
+ * with MADCTL.MV set (rotation 1 & 3) that is the screen's X axis, otherwise the Y axis
+ */
+#if ST7789_ROTATION == 1 || ST7789_ROTATION == 3
+#define ST7789_SCROLL_ALONG_X
+#endif
+
 #ifdef USING_135X240
 
     #if ST7789_ROTATION == 0
@@ -204,6 +244,8 @@ extern uint DmaChann;
 #define ST7789_RAMRD   0x2E
 
 #define ST7789_PTLAR   0x30
+#define ST7789_VSCRDEF 0x33
+#define ST7789_VSCSAD  0x37
 #define ST7789_COLMOD  0x3A
 #define ST7789_MADCTL  0x36
 
@@ -233,6 +275,10 @@ extern uint DmaChann;
 /* Advanced options */
 #define ST7789_COLOR_MODE_16bit 0x55    //  RGB565 (16bit)
 #define ST7789_COLOR_MODE_18bit 0x66    //  RGB666 (18bit)
+#define ST7789_COLOR_MODE_12bit 0x53    //  RGB444 (12bit)
+
+/* RGB565 color -> RGB444 pixel for the 12-bit bus */
+#define ST7789_RGB444(c) ((((c) >> 4) & 0xF00) | (((c) >> 3) & 0x0F0) | (((c) >> 1) & 0x00F))
 
 /* Basic operations */
 #define ST7789_RST_Clr() gpio_put(ST7789_RST_PIN, 0)
@@ -256,9 +302,20 @@ void ST7789_DrawLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_
 void ST7789_DrawRectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color);
 void ST7789_DrawCircle(uint16_t x0, uint16_t y0, uint8_t r, uint16_t color);
 void ST7789_DrawImage(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *data);
+void ST7789_DrawImageStrided(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t *data, uint16_t stride);
+void ST7789_QueueImage(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *data);
+void ST7789_QueueImageStrided(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *data, uint16_t stride);
+void ST7789_GetQueueStats(ST7789_QueueStats *stats);
+void ST7789_AbortQueue(void);
+void ST7789_ConvertRGB444(uint16_t *buf, uint32_t px);
 void ST7789_InvertColors(uint8_t invert);
 
-/* Text functions. */
+/* Hardware scrolling, positions are screen coordinates along the scroll axis */
+void ST7789_SetScrollArea(uint16_t start, uint16_t len);
+void ST7789_SetScrollOffset(uint16_t offset);
+void ST7789_ResetScroll(void);
+
+/* Text functions, usable before lv_init and from fault handlers (call ST7789_AbortQueue first). */
 void ST7789_WriteChar(uint16_t x, uint16_t y, char ch, FontDef font, uint16_t color, uint16_t bgcolor);
 void ST7789_WriteString(uint16_t x, uint16_t y, const char *str, FontDef font, uint16_t color, uint16_t bgcolor);
 
@@ -0,0 +1,129 @@
+/**
+ * @file bench_digit_atlas.c
+ * 端口读数(ui_font_xlm_42, 8bpp)每次更新数值的渲染耗时：逐像素混合 vs 预混合的数字贴图
+ * 读数的一部分压在功率占比条上，先只登记panel背景，再把占比条的颜色也登记上
+ * 每一步都和逐像素混合的结果逐像素比较
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lvgl.h"
+#include "ui.h"
+#include "digit_readout.h"
+#include "power_gauge.h"
+
+#define HOR_RES			(240)
+#define VER_RES			(135)
+#define BENCH_STEPS		(2000)
+#define PANEL_COLOR		(0x4FD3EA)
+#define ACT_COLOR		(0xE8E8E8)
+#define ZERO_COLOR		(0xBBBBBB)
+
+static lv_color_t draw_buf_1[HOR_RES * VER_RES];
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+
+static lv_color_t screen[HOR_RES * VER_RES];		//flush过的内容拼成整屏
+static lv_color_t *reference;						//逐像素混合时每一步的整屏内容
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
+	lv_coord_t w = lv_area_get_width(area);
+	for (lv_coord_t y = area->y1; y <= area->y2; y++) {
+		memcpy(&screen[y * HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+		color_p += w;
+	}
+	lv_disp_flush_ready(drv);
+}
+
+static uint64_t now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static void run(const char *name, lv_obj_t *readout, bool record) {
+	digit_readout_atlas_stats_t s0, s1;
+	digit_readout_atlas_get_stats(&s0);
+
+	uint64_t render_ns = 0;
+	uint32_t wrong_px = 0;
+	for (uint32_t i = 0; i < BENCH_STEPS; i++) {
+		//第一组数跨越各种位数，让前导0的颜色也不断变化
+		digit_readout_set_number(readout, 0, 4, (i * 37) % 3000 / (1 + i % 7 * 40), lv_color_hex(ACT_COLOR),
+								 lv_color_hex(ZERO_COLOR));
+		digit_readout_set_number(readout, 7, 4, (i * 53) % 9000, lv_color_hex(ACT_COLOR), lv_color_hex(ZERO_COLOR));
+		uint64_t t0 = now_ns();
+		lv_refr_now(NULL);
+		render_ns += now_ns() - t0;
+
+		lv_color_t *ref = &reference[(size_t)i * HOR_RES * VER_RES];
+		if (record) {
+			memcpy(ref, screen, sizeof(screen));
+		} else {
+			for (uint32_t p = 0; p < HOR_RES * VER_RES; p++) wrong_px += screen[p].full != ref[p].full;
+		}
+	}
+
+	digit_readout_atlas_get_stats(&s1);
+	printf("%-12s render %7.2f us/step, atlas hits %5.2f misses %5.2f per step, %u slots / %u B, "
+		   "%u wrong px\n", name, (double)render_ns / BENCH_STEPS / 1000.0,
+		   (double)(s1.hits - s0.hits) / BENCH_STEPS, (double)(s1.misses - s0.misses) / BENCH_STEPS,
+		   (unsigned)s1.slots, (unsigned)s1.bytes, (unsigned)wrong_px);
+}
+
+int main(void) {
+	lv_init();
+	lv_disp_draw_buf_init(&draw_buf, draw_buf_1, NULL, HOR_RES * VER_RES);
+	lv_disp_drv_init(&disp_drv);
+	disp_drv.hor_res = HOR_RES;
+	disp_drv.ver_res = VER_RES;
+	disp_drv.flush_cb = flush_cb;
+	disp_drv.draw_buf = &draw_buf;
+	lv_disp_drv_register(&disp_drv);
+
+	reference = malloc((size_t)BENCH_STEPS * HOR_RES * VER_RES * sizeof(lv_color_t));
+	if (reference == NULL) return 1;
+
+	lv_obj_t *panel = lv_obj_create(lv_scr_act());
+	lv_obj_set_size(panel, HOR_RES, 60);
+	lv_obj_set_style_bg_color(panel, lv_color_hex(PANEL_COLOR), LV_PART_MAIN);
+	lv_obj_set_style_border_width(panel, 0, LV_PART_MAIN);
+	lv_obj_set_style_pad_all(panel, 4, LV_PART_MAIN);
+	lv_obj_clear_flag(panel, LV_OBJ_FLAG_SCROLLABLE);
+
+	//占比条盖住读数的左边一部分，那里的背景是另一种纯色
+	lv_obj_t *gauge = power_gauge_create(panel);
+	lv_obj_set_size(gauge, lv_pct(100), lv_pct(100));
+	power_gauge_set_shade(gauge, lv_color_black(), LV_OPA_20);
+	power_gauge_set_value(gauge, POWER_GAUGE_RANGE * 3 / 10, LV_ANIM_OFF);
+
+	lv_obj_t *readout = digit_readout_create(panel);
+	lv_obj_set_style_text_font(readout, &ui_font_xlm_42, LV_PART_MAIN);
+	lv_obj_center(readout);
+	digit_readout_set_text(readout, 0, "0000mA 0000mW", lv_color_hex(ACT_COLOR));
+	lv_refr_now(NULL);
+
+	run("blend", readout, true);
+
+	//和刷新前的状态保持一致，两次的每一步才可以逐像素比较
+	digit_readout_set_text(readout, 0, "0000mA 0000mW", lv_color_hex(ACT_COLOR));
+	lv_obj_invalidate(panel);
+	lv_refr_now(NULL);
+
+	digit_readout_atlas_add(&ui_font_xlm_42, lv_color_hex(ACT_COLOR), lv_color_hex(PANEL_COLOR));
+	digit_readout_atlas_add(&ui_font_xlm_42, lv_color_hex(ZERO_COLOR), lv_color_hex(PANEL_COLOR));
+	run("atlas panel", readout, false);
+
+	lv_color_t shade_bg = lv_color_mix(lv_color_black(), lv_color_hex(PANEL_COLOR), LV_OPA_20);
+	digit_readout_set_text(readout, 0, "0000mA 0000mW", lv_color_hex(ACT_COLOR));
+	lv_obj_invalidate(panel);
+	lv_refr_now(NULL);
+	digit_readout_atlas_add(&ui_font_xlm_42, lv_color_hex(ACT_COLOR), shade_bg);
+	digit_readout_atlas_add(&ui_font_xlm_42, lv_color_hex(ZERO_COLOR), shade_bg);
+	run("atlas +shade", readout, false);
+
+	free(reference);
+	return 0;
+}
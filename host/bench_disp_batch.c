@@ -0,0 +1,98 @@
+/**
+ * @file bench_disp_batch.c
+ * 通过lv_port_disp.c把LVGL接到pico_fake上的ST7789驱动，每帧更新四个端口的数值标签，
+ * 统计每帧的flush_cb调用次数、在DMA中断里归还缓冲(lv_disp_flush_ready)的次数、
+ * 窗口命令数、DMA中断次数和RAMWR字节数；
+ * 同一份代码分别按DISP_BUF_MODE_TWO、DISP_BUF_MODE_DIRECT（关闭/开启DISP_ROW_DIFF）编译，比较几种刷新方式
+ * 标签每帧都重新设置文本，但数值每VALUE_HOLD帧才变一次，中间几帧重新渲染出的内容完全相同
+ */
+
+#include <stdio.h>
+#include "lvgl.h"
+#include "lv_port_disp.h"
+#include "st7789.h"
+#include "pico_fake.h"
+#include "hardware/gpio.h"
+
+#define PORT_CNT		(4)
+#define BENCH_FRAMES	(200)
+#define VALUE_HOLD		(4)
+
+static void (*port_flush_cb)(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p);
+static uint32_t flush_calls;
+static uint32_t caset_cnt;
+static uint32_t ramwr_bytes;
+static uint8_t last_cmd;
+static uint32_t irq_flush_ready;	//在DMA完成回调里调用lv_disp_flush_ready的次数
+static bool in_dma_cb;
+
+/*用链接器的--wrap拦截lv_port_disp.c里的dma_handler和lv_disp_flush_ready*/
+void __real_dma_handler(void);
+void __real_lv_disp_flush_ready(lv_disp_drv_t *disp_drv);
+
+void __wrap_dma_handler(void) {
+	in_dma_cb = true;
+	__real_dma_handler();
+	in_dma_cb = false;
+}
+
+void __wrap_lv_disp_flush_ready(lv_disp_drv_t *disp_drv) {
+	if (in_dma_cb) irq_flush_ready++;
+	__real_lv_disp_flush_ready(disp_drv);
+}
+
+static void counting_flush(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
+	flush_calls++;
+	port_flush_cb(drv, area, color_p);
+}
+
+static void sink(spi_inst_t *spi, uint8_t byte) {
+	(void)spi;
+	if (!gpio_get(ST7789_DC_PIN)) {
+		last_cmd = byte;
+		if (byte == ST7789_CASET) caset_cnt++;
+	} else if (last_cmd == ST7789_RAMWR) {
+		ramwr_bytes++;
+	}
+}
+
+int main(void) {
+	lv_init();
+	pico_fake_set_spi_sink(sink);
+	lv_port_disp_init();
+
+	lv_disp_t *disp = lv_disp_get_default();
+	port_flush_cb = disp->driver->flush_cb;
+	disp->driver->flush_cb = counting_flush;
+
+	//四个端口的电流标签，和面板上的布局一样上下错开，不会被LVGL合并成一块
+	lv_obj_t *scr = lv_scr_act();
+	lv_obj_set_style_bg_color(scr, lv_color_hex(0x00DC26), LV_PART_MAIN);
+	lv_obj_t *labels[PORT_CNT];
+	for (int i = 0; i < PORT_CNT; i++) {
+		labels[i] = lv_label_create(scr);
+		lv_obj_set_pos(labels[i], 8 + (i % 2) * 120, 8 + i * 32);
+		lv_label_set_text(labels[i], "0000mA");
+	}
+	lv_refr_now(NULL);
+
+	pico_fake_reset_stats();
+	flush_calls = 0;
+	irq_flush_ready = 0;
+	caset_cnt = 0;
+	ramwr_bytes = 0;
+	for (uint32_t f = 0; f < BENCH_FRAMES; f++) {
+		for (int i = 0; i < PORT_CNT; i++) {
+			lv_label_set_text_fmt(labels[i], "%04umA", (unsigned)(((f / VALUE_HOLD) * 37 + i * 211) % 3000));
+		}
+		lv_refr_now(NULL);
+	}
+
+	//dma starts包括控制通道和链式触发的每一次运行
+	printf("%-13s flush_cb %4.2f/frame, flush_ready in irq %4.2f/frame, windows %4.2f/frame, "
+		   "dma irqs %4.2f/frame, dma starts %6.2f/frame, ramwr %6u B/frame\n", DISP_BENCH_NAME,
+		   (double)flush_calls / BENCH_FRAMES, (double)irq_flush_ready / BENCH_FRAMES,
+		   (double)caset_cnt / BENCH_FRAMES, (double)pico_fake_stats.dma_irqs / BENCH_FRAMES,
+		   (double)pico_fake_stats.dma_starts / BENCH_FRAMES, (unsigned)(ramwr_bytes / BENCH_FRAMES));
+	return 0;
+}
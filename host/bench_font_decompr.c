@@ -0,0 +1,105 @@
+/**
+ * @file bench_font_decompr.c
+ * 28px读数标签每次重绘的渲染耗时：不压缩的lv_font_montserrat_28和压缩的lv_font_montserrat_28_compressed(都是4bpp)
+ * 同一份代码分别链接开/关LV_FONT_FMT_TXT_DECOMPR_CACHE_SIZE的LVGL，三种情况的帧哈希应当相同，
+ * 另外输出数字字形在flash里占的字节数，也就是换成压缩字体省下的空间
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "lvgl.h"
+
+/*lv_conf.h里没有打开这个字体，直接编译进来；压缩的版本在font_montserrat_28_compressed.c里，两个文件的静态变量同名*/
+#undef LV_FONT_MONTSERRAT_28
+#define LV_FONT_MONTSERRAT_28 1
+#include "src/font/lv_font_montserrat_28.c"
+
+LV_FONT_DECLARE(lv_font_montserrat_28_compressed)
+
+#define HOR_RES			(240)
+#define VER_RES			(135)
+#define BENCH_REDRAWS	(2000)
+
+static lv_color_t draw_buf_1[HOR_RES * VER_RES];
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+
+static lv_color_t screen[HOR_RES * VER_RES];
+static uint32_t frames_hash;
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
+	lv_coord_t w = lv_area_get_width(area);
+	for (lv_coord_t y = area->y1; y <= area->y2; y++) {
+		memcpy(&screen[y * HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+		color_p += w;
+	}
+	lv_disp_flush_ready(drv);
+}
+
+static uint64_t now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static void hash_screen(void) {
+	const uint8_t *p = (const uint8_t *)screen;
+	for (uint32_t i = 0; i < sizeof(screen); i++) {
+		frames_hash = (frames_hash ^ p[i]) * 16777619u;
+	}
+}
+
+/**
+ * @brief '0'~'9'的字形在glyph_bitmap里占的字节数，这几个字形的ID是连续的
+ */
+static uint32_t digit_bitmap_bytes(const lv_font_t *font) {
+	const lv_font_fmt_txt_dsc_t *fdsc = font->dsc;
+	uint32_t first = fdsc->cmaps[0].glyph_id_start + '0' - fdsc->cmaps[0].range_start;
+	return fdsc->glyph_dsc[first + 10].bitmap_index - fdsc->glyph_dsc[first].bitmap_index;
+}
+
+static void run(const char *name, lv_obj_t *label, const lv_font_t *font) {
+	lv_obj_set_style_text_font(label, font, LV_PART_MAIN);
+	lv_refr_now(NULL);
+
+	frames_hash = 2166136261u;
+	uint64_t render_ns = 0;
+	for (uint32_t i = 0; i < BENCH_REDRAWS; i++) {
+		lv_label_set_text_fmt(label, "%02u.%03u V\n%04u mA", (unsigned)((i * 7) % 24), (unsigned)((i * 37) % 1000),
+							  (unsigned)((i * 53) % 3000));
+		uint64_t t0 = now_ns();
+		lv_refr_now(NULL);
+		render_ns += now_ns() - t0;
+		hash_screen();
+	}
+
+	printf("%-10s %-11s render %7.2f us/redraw, digits %5u B in flash, frames hash %08x\n", name,
+		   LV_FONT_FMT_TXT_DECOMPR_CACHE_SIZE ? "cache" : "no cache", (double)render_ns / BENCH_REDRAWS / 1000.0,
+		   (unsigned)digit_bitmap_bytes(font), (unsigned)frames_hash);
+}
+
+int main(void) {
+	lv_init();
+	lv_disp_draw_buf_init(&draw_buf, draw_buf_1, NULL, HOR_RES * VER_RES);
+	lv_disp_drv_init(&disp_drv);
+	disp_drv.hor_res = HOR_RES;
+	disp_drv.ver_res = VER_RES;
+	disp_drv.flush_cb = flush_cb;
+	disp_drv.draw_buf = &draw_buf;
+	lv_disp_drv_register(&disp_drv);
+
+	lv_obj_t *label = lv_label_create(lv_scr_act());
+	lv_obj_set_pos(label, 8, 8);
+
+	run("plain", label, &lv_font_montserrat_28);
+	run("compressed", label, &lv_font_montserrat_28_compressed);
+
+#if LV_FONT_FMT_TXT_DECOMPR_CACHE_SIZE
+	lv_font_fmt_txt_decompr_cache_stats_t s;
+	lv_font_fmt_txt_decompr_cache_get_stats(&s);
+	printf("decompressed glyph cache: %u hits, %u misses, %u glyphs / %u B cached\n", (unsigned)s.hits,
+		   (unsigned)s.misses, (unsigned)s.glyphs, (unsigned)s.used);
+#endif
+	return 0;
+}
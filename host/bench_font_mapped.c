@@ -0,0 +1,545 @@
+/**
+ * @file bench_font_mapped.c
+ * 把编译进来的字体写成LVGL的二进制字体文件，再mmap进来当作flash里的字体镜像：
+ *  - lv_font_load_mapped：字形位图、cmap和字距表直接用镜像里的，只分配字形描述
+ *  - lv_font_load：通过lv_fs读文件，全部复制到LVGL的堆里
+ * 比较加载时间和占用的堆，并检查两种加载方式画出来的画面和原来的C字体完全相同
+ * 字形头对齐到字节(前进宽度16位)时才能直接使用镜像；12位的版本用来检查lv_font_load_mapped会拒绝它
+ * 检查每个cmap范围后面的第一个字符（range_start + range_length）在没有其他cmap包含时找不到字形，
+ * 不会读到FORMAT0_FULL偏移列表之后或者字形描述之后（cmap整体移出ASCII，不经过ASCII字形表）
+ * 最后把镜像的cmap和字距表逐处改坏（字形ID、类别号越界，列表太短），检查lv_font_load_mapped都拒绝加载
+ */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "lvgl.h"
+#include "ui.h"
+
+#define HOR_RES			(240)
+#define VER_RES			(135)
+#define BENCH_LOADS		(50)
+#define RANGE_SHIFT		(0x1000)	//检查cmap范围的结尾时把所有cmap移到这之后
+
+/*和lv_font_loader.c里的文件格式一致*/
+typedef struct {
+	uint32_t version;
+	uint16_t tables_count;
+	uint16_t font_size;
+	uint16_t ascent;
+	int16_t descent;
+	uint16_t typo_ascent;
+	int16_t typo_descent;
+	uint16_t typo_line_gap;
+	int16_t min_y;
+	int16_t max_y;
+	uint16_t default_advance_width;
+	uint16_t kerning_scale;
+	uint8_t index_to_loc_format;
+	uint8_t glyph_id_format;
+	uint8_t advance_width_format;
+	uint8_t bits_per_pixel;
+	uint8_t xy_bits;
+	uint8_t wh_bits;
+	uint8_t advance_width_bits;
+	uint8_t compression_id;
+	uint8_t subpixels_mode;
+	uint8_t padding;
+	int16_t underline_position;
+	uint16_t underline_thickness;
+} font_header_bin_t;
+
+typedef struct {
+	uint32_t data_offset;
+	uint32_t range_start;
+	uint16_t range_length;
+	uint16_t glyph_id_start;
+	uint16_t data_entries_count;
+	uint8_t format_type;
+	uint8_t padding;
+} cmap_table_bin_t;
+
+typedef struct {
+	uint8_t data[256 * 1024];
+	uint32_t len;
+	uint32_t bit_pos;		//写位图时当前字节里已经用掉的位数
+	uint32_t glyphs;
+	uint32_t cmap;			//cmap表的起始位置
+	uint32_t kern;			//kern表的起始位置，0: 没有字距表
+} bin_buf_t;
+
+static lv_color_t draw_buf_1[HOR_RES * VER_RES];
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+
+static lv_color_t screen[HOR_RES * VER_RES];
+static bin_buf_t bin;
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
+	lv_coord_t w = lv_area_get_width(area);
+	for (lv_coord_t y = area->y1; y <= area->y2; y++) {
+		memcpy(&screen[y * HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+		color_p += w;
+	}
+	lv_disp_flush_ready(drv);
+}
+
+static uint64_t now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static uint32_t hash_screen(void) {
+	uint32_t hash = 2166136261u;
+	const uint8_t *p = (const uint8_t *)screen;
+	for (uint32_t i = 0; i < sizeof(screen); i++) {
+		hash = (hash ^ p[i]) * 16777619u;
+	}
+	return hash;
+}
+
+/**********************
+ *  用stdio实现的lv_fs驱动，盘符H
+ **********************/
+
+static void *fs_open(lv_fs_drv_t *drv, const char *path, lv_fs_mode_t mode) {
+	LV_UNUSED(drv);
+	LV_UNUSED(mode);
+	return fopen(path, "rb");
+}
+
+static lv_fs_res_t fs_close(lv_fs_drv_t *drv, void *file_p) {
+	LV_UNUSED(drv);
+	fclose(file_p);
+	return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_read(lv_fs_drv_t *drv, void *file_p, void *buf, uint32_t btr, uint32_t *br) {
+	LV_UNUSED(drv);
+	uint32_t n = (uint32_t)fread(buf, 1, btr, file_p);
+	if (br) *br = n;
+	return n == btr ? LV_FS_RES_OK : LV_FS_RES_FS_ERR;
+}
+
+static lv_fs_res_t fs_seek(lv_fs_drv_t *drv, void *file_p, uint32_t pos, lv_fs_whence_t whence) {
+	LV_UNUSED(drv);
+	int w = whence == LV_FS_SEEK_SET ? SEEK_SET : (whence == LV_FS_SEEK_CUR ? SEEK_CUR : SEEK_END);
+	return fseek(file_p, pos, w) == 0 ? LV_FS_RES_OK : LV_FS_RES_FS_ERR;
+}
+
+static lv_fs_res_t fs_tell(lv_fs_drv_t *drv, void *file_p, uint32_t *pos_p) {
+	LV_UNUSED(drv);
+	*pos_p = (uint32_t)ftell(file_p);
+	return LV_FS_RES_OK;
+}
+
+static void fs_init(void) {
+	static lv_fs_drv_t drv;
+	lv_fs_drv_init(&drv);
+	drv.letter = 'H';
+	drv.open_cb = fs_open;
+	drv.close_cb = fs_close;
+	drv.read_cb = fs_read;
+	drv.seek_cb = fs_seek;
+	drv.tell_cb = fs_tell;
+	lv_fs_drv_register(&drv);
+}
+
+/**********************
+ *  二进制字体的写入
+ **********************/
+
+static void bin_put(const void *p, uint32_t len) {
+	memcpy(&bin.data[bin.len], p, len);
+	bin.len += len;
+}
+
+static void bin_u32_at(uint32_t pos, uint32_t v) {
+	memcpy(&bin.data[pos], &v, sizeof(v));
+}
+
+static void bin_align4(void) {
+	while (bin.len & 3) bin.data[bin.len++] = 0;
+}
+
+/**
+ * @brief 从高位开始写n位，bit_pos为0时先开一个新字节
+ */
+static void bin_bits(uint32_t v, uint8_t n) {
+	while (n--) {
+		if (bin.bit_pos == 0) bin.data[bin.len++] = 0;
+		if (v >> n & 1) bin.data[bin.len - 1] |= 0x80 >> bin.bit_pos;
+		bin.bit_pos = (bin.bit_pos + 1) & 7;
+	}
+}
+
+/**
+ * @brief 写表头，返回表的起始位置，写完后用bin_end填长度
+ */
+static uint32_t bin_begin(const char *label) {
+	uint32_t start = bin.len;
+	uint32_t len = 0;
+	bin_put(&len, 4);
+	bin_put(label, 4);
+	return start;
+}
+
+static void bin_end(uint32_t start) {
+	bin_align4();
+	bin_u32_at(start, bin.len - start);
+}
+
+static uint32_t glyph_count(const lv_font_fmt_txt_dsc_t *dsc) {
+	uint32_t cnt = 1;
+	for (uint16_t i = 0; i < dsc->cmap_num; i++) {
+		const lv_font_fmt_txt_cmap_t *cmap = &dsc->cmaps[i];
+		uint32_t last = cmap->glyph_id_start;
+		if (cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
+			last += cmap->range_length;
+		} else if (cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) {
+			last += cmap->list_length;
+		} else {
+			for (uint16_t k = 0; k < cmap->list_length; k++) {
+				uint32_t ofs = cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL ?
+							   ((const uint8_t *)cmap->glyph_id_ofs_list)[k] : ((const uint16_t *)cmap->glyph_id_ofs_list)[k];
+				if (cmap->glyph_id_start + ofs + 1 > last) last = cmap->glyph_id_start + ofs + 1;
+			}
+		}
+		if (last > cnt) cnt = last;
+	}
+	return cnt;
+}
+
+/**
+ * @brief 把不压缩的C字体按lv_font_conv的二进制格式写进bin
+ * @param adv_bits 前进宽度的位数，字形头一共adv_bits + 8 * 4位
+ */
+static void font_to_bin(const lv_font_t *font, uint8_t adv_bits) {
+	const lv_font_fmt_txt_dsc_t *dsc = font->dsc;
+	uint32_t glyphs = glyph_count(dsc);
+	bin.len = 0;
+	bin.bit_pos = 0;
+	bin.glyphs = glyphs;
+	bin.kern = 0;
+
+	/*head*/
+	uint32_t start = bin_begin("head");
+	font_header_bin_t head = {
+		.version = 1,
+		.tables_count = dsc->kern_dsc ? 4 : 3,
+		.font_size = (uint16_t)font->line_height,
+		.ascent = (uint16_t)(font->line_height - font->base_line),
+		.descent = (int16_t)-font->base_line,
+		.kerning_scale = dsc->kern_scale,
+		.index_to_loc_format = 1,
+		.glyph_id_format = 1,
+		.advance_width_format = 1,
+		.bits_per_pixel = (uint8_t)dsc->bpp,
+		.xy_bits = 8,
+		.wh_bits = 8,
+		.advance_width_bits = adv_bits,
+		.subpixels_mode = font->subpx,
+		.underline_position = font->underline_position,
+		.underline_thickness = font->underline_thickness,
+	};
+	bin_put(&head, sizeof(head));
+	bin_end(start);
+
+	/*cmap：子表后面依次是各自的列表，每个列表对齐到4字节*/
+	start = bin_begin("cmap");
+	bin.cmap = start;
+	uint32_t cnt = dsc->cmap_num;
+	bin_put(&cnt, 4);
+	uint32_t tables = bin.len;
+	bin.len += dsc->cmap_num * sizeof(cmap_table_bin_t);
+	for (uint16_t i = 0; i < dsc->cmap_num; i++) {
+		const lv_font_fmt_txt_cmap_t *cmap = &dsc->cmaps[i];
+		cmap_table_bin_t t = {
+			.data_offset = bin.len - start,
+			.range_start = cmap->range_start,
+			.range_length = cmap->range_length,
+			.glyph_id_start = cmap->glyph_id_start,
+			.format_type = (uint8_t)cmap->type,
+		};
+		if (cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
+			t.data_entries_count = cmap->list_length;
+			bin_put(cmap->glyph_id_ofs_list, cmap->list_length);
+		} else if (cmap->type != LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
+			t.data_entries_count = cmap->list_length;
+			bin_put(cmap->unicode_list, cmap->list_length * 2);
+			if (cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) bin_put(cmap->glyph_id_ofs_list, cmap->list_length * 2);
+		}
+		bin_align4();
+		memcpy(&bin.data[tables + i * sizeof(t)], &t, sizeof(t));
+	}
+	bin_end(start);
+
+	/*loca，偏移量从glyf表头开始算，先占位*/
+	start = bin_begin("loca");
+	bin_put(&glyphs, 4);
+	uint32_t loca = bin.len;
+	bin.len += glyphs * 4;
+	bin_end(start);
+
+	/*glyf：每个字形的头和位图连续写，按字节结束*/
+	uint32_t glyf = bin_begin("glyf");
+	for (uint32_t g = 0; g < glyphs; g++) {
+		const lv_font_fmt_txt_glyph_dsc_t *gd = &dsc->glyph_dsc[g];
+		bin_u32_at(loca + g * 4, bin.len - glyf);
+		bin.bit_pos = 0;
+		bin_bits(gd->adv_w, adv_bits);
+		bin_bits((uint8_t)gd->ofs_x, 8);
+		bin_bits((uint8_t)gd->ofs_y, 8);
+		bin_bits(gd->box_w, 8);
+		bin_bits(gd->box_h, 8);
+		uint32_t bytes = ((uint32_t)gd->box_w * gd->box_h * dsc->bpp + 7) / 8;
+		for (uint32_t k = 0; k < bytes; k++) bin_bits(dsc->glyph_bitmap[gd->bitmap_index + k], 8);
+	}
+	bin.bit_pos = 0;
+	bin_end(glyf);
+
+	/*kern，只支持按类的格式(lv_font_conv的默认输出)*/
+	if (dsc->kern_dsc) {
+		const lv_font_fmt_txt_kern_classes_t *kc = dsc->kern_dsc;
+		start = bin_begin("kern");
+		bin.kern = start;
+		uint8_t type[4] = {3, 0, 0, 0};
+		bin_put(type, 4);
+		uint16_t map_len = (uint16_t)glyphs;
+		bin_put(&map_len, 2);
+		bin_put(&kc->left_class_cnt, 1);
+		bin_put(&kc->right_class_cnt, 1);
+		bin_put(kc->left_class_mapping, map_len);
+		bin_put(kc->right_class_mapping, map_len);
+		bin_put(kc->class_pair_values, kc->left_class_cnt * kc->right_class_cnt);
+		bin_end(start);
+	}
+}
+
+/**********************
+ *  测试
+ **********************/
+
+static uint32_t draw_text(lv_obj_t *label, const lv_font_t *font) {
+	lv_obj_set_style_text_font(label, font, LV_PART_MAIN);
+	lv_label_set_text(label, "Hub 5.012 V\n0123 mA 4567 mW\nAVWTavwt{}~");
+	lv_refr_now(NULL);
+	return hash_screen();
+}
+
+static uint32_t heap_used(void) {
+	lv_mem_monitor_t mon;
+	lv_mem_monitor(&mon);
+	return mon.total_size - mon.free_size;
+}
+
+static void run(const char *name, const lv_font_t *ref, uint8_t adv_bits, lv_obj_t *label) {
+	font_to_bin(ref, adv_bits);
+	char path[64];
+	snprintf(path, sizeof(path), "/tmp/bench_font_mapped_%u.bin", (unsigned)adv_bits);
+	FILE *f = fopen(path, "wb");
+	fwrite(bin.data, 1, bin.len, f);
+	fclose(f);
+
+	int fd = open(path, O_RDONLY);
+	const void *image = mmap(NULL, bin.len, PROT_READ, MAP_PRIVATE, fd, 0);
+	uint32_t ref_hash = draw_text(label, ref);
+	printf("%s, %u bit glyph headers, %u B image:\n", name, (unsigned)(adv_bits + 32), (unsigned)bin.len);
+
+	/*镜像是只读映射，直接使用时写到镜像里就会出错*/
+	uint32_t heap0 = heap_used();
+	uint64_t t0 = now_ns();
+	lv_font_t *font = lv_font_load_mapped(image, bin.len);
+	uint64_t load_ns = now_ns() - t0;
+	if (font) {
+		uint32_t heap = heap_used() - heap0;
+		bool same = draw_text(label, font) == ref_hash;
+		lv_font_free_mapped(font);
+		for (uint32_t i = 0; i < BENCH_LOADS; i++) {
+			t0 = now_ns();
+			font = lv_font_load_mapped(image, bin.len);
+			load_ns += now_ns() - t0;
+			lv_font_free_mapped(font);
+		}
+		printf("  lv_font_load_mapped %8.1f us, %6u B heap, frame %s\n", (double)load_ns / (BENCH_LOADS + 1) / 1000.0,
+			   (unsigned)heap, same ? "identical" : "DIFFERENT");
+	} else {
+		printf("  lv_font_load_mapped rejected the image\n");
+	}
+
+	snprintf(path, sizeof(path), "H:/tmp/bench_font_mapped_%u.bin", (unsigned)adv_bits);
+	t0 = now_ns();
+	font = lv_font_load(path);
+	load_ns = now_ns() - t0;
+	if (font) {
+		uint32_t heap = heap_used() - heap0;
+		bool same = draw_text(label, font) == ref_hash;
+		lv_font_free(font);
+		printf("  lv_font_load        %8.1f us, %6u B heap, frame %s\n", (double)load_ns / 1000.0, (unsigned)heap,
+			   same ? "identical" : "DIFFERENT");
+	} else {
+		printf("  lv_font_load        failed (LVGL heap: %u B free)\n", (unsigned)(LV_MEM_SIZE - heap_used()));
+	}
+	printf("  heap after freeing: %+d B\n", (int)(heap_used() - heap0));
+
+	lv_obj_set_style_text_font(label, ref, LV_PART_MAIN);
+	munmap((void *)image, bin.len);
+	close(fd);
+}
+
+static bool cmap_covers(const lv_font_fmt_txt_dsc_t *dsc, uint32_t letter) {
+	for (uint16_t i = 0; i < dsc->cmap_num; i++) {
+		if (letter - dsc->cmaps[i].range_start < dsc->cmaps[i].range_length) return true;
+	}
+	return false;
+}
+
+/**
+ * @brief 所有cmap移动RANGE_SHIFT后，每个cmap的最后一个字符和原来的C字体相同，
+ * 紧接在范围后面、不属于任何cmap的字符找不到字形
+ * @return 出错的字符数
+ */
+static int run_range_ends(const char *name, const lv_font_t *ref) {
+	const lv_font_fmt_txt_dsc_t *ref_dsc = ref->dsc;
+	font_to_bin(ref, 16);
+	uint32_t tables = bin.cmap + 12;
+	for (uint16_t i = 0; i < ref_dsc->cmap_num; i++) {
+		uint32_t pos = tables + i * sizeof(cmap_table_bin_t) + offsetof(cmap_table_bin_t, range_start);
+		uint32_t start;
+		memcpy(&start, &bin.data[pos], 4);
+		bin_u32_at(pos, start + RANGE_SHIFT);
+	}
+	lv_font_t *font = lv_font_load_mapped(bin.data, bin.len);
+	if (font == NULL) {
+		printf("%s, cmap range ends: lv_font_load_mapped rejected the image\n", name);
+		return 1;
+	}
+
+	const lv_font_fmt_txt_dsc_t *dsc = font->dsc;
+	int errors = 0;
+	for (uint16_t i = 0; i < dsc->cmap_num; i++) {
+		uint32_t last = dsc->cmaps[i].range_start + dsc->cmaps[i].range_length - 1;
+		lv_font_glyph_dsc_t g, g_ref;
+		bool found = lv_font_get_glyph_dsc(font, &g, last, 0);
+		bool found_ref = lv_font_get_glyph_dsc(ref, &g_ref, last - RANGE_SHIFT, 0);
+		if (found != found_ref || (found && (g.adv_w != g_ref.adv_w || g.box_w != g_ref.box_w ||
+											 g.box_h != g_ref.box_h))) {
+			printf("  cmap %u: last letter 0x%X differs from the C font\n", (unsigned)i, (unsigned)last);
+			errors++;
+		}
+		if (!cmap_covers(dsc, last + 1) && lv_font_get_glyph_dsc(font, &g, last + 1, 0)) {
+			printf("  cmap %u: letter 0x%X after the range has a glyph\n", (unsigned)i, (unsigned)(last + 1));
+			errors++;
+		}
+	}
+	lv_font_free_mapped(font);
+	printf("%s, cmap range ends: %d wrong letters\n", name, errors);
+	return errors;
+}
+
+/**
+ * @brief 在镜像的副本里改写一处，lv_font_load_mapped应该拒绝加载
+ * @return 1: 被加载了
+ */
+static int expect_reject(const char *what, uint32_t pos, const void *val, uint32_t len) {
+	static uint8_t img[sizeof(bin.data)];
+	memcpy(img, bin.data, bin.len);
+	memcpy(&img[pos], val, len);
+
+	lv_font_t *font = lv_font_load_mapped(img, bin.len);
+	printf("  %-46s %s\n", what, font ? "LOADED" : "rejected");
+	if (font == NULL) return 0;
+	lv_font_free_mapped(font);
+	return 1;
+}
+
+/**
+ * @brief 改坏字体镜像的cmap和字距表，每一处都应该被lv_font_load_mapped发现
+ */
+static int run_corrupt(const char *name, const lv_font_t *ref) {
+	const lv_font_fmt_txt_dsc_t *dsc = ref->dsc;
+	font_to_bin(ref, 16);
+	printf("%s, corrupted images:\n", name);
+
+	int errors = 0;
+	uint32_t tables = bin.cmap + 12;
+	uint32_t last = tables + (dsc->cmap_num - 1) * sizeof(cmap_table_bin_t);
+	uint16_t gid = (uint16_t)bin.glyphs;
+	errors += expect_reject("cmap 0 starts after the last glyph", tables + offsetof(cmap_table_bin_t, glyph_id_start),
+							&gid, 2);
+
+	//最后一个子表的最后一个字形越界，带偏移列表的子表按列表里最大的偏移算
+	cmap_table_bin_t t;
+	memcpy(&t, &bin.data[last], sizeof(t));
+	uint16_t top = t.format_type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY ? t.range_length - 1 : t.data_entries_count - 1;
+	const uint8_t *list = &bin.data[bin.cmap + t.data_offset];
+	if (t.format_type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL || t.format_type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
+		top = 0;
+		for (uint16_t k = 0; k < t.data_entries_count; k++) {
+			uint16_t ofs;
+			if (t.format_type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
+				ofs = list[k];
+			} else {
+				memcpy(&ofs, &list[(t.data_entries_count + k) * 2], 2);
+			}
+			if (ofs > top) top = ofs;
+		}
+	}
+	gid = (uint16_t)(bin.glyphs - top);
+	errors += expect_reject("last cmap ends after the last glyph", last + offsetof(cmap_table_bin_t, glyph_id_start),
+							&gid, 2);
+
+	//子表0改成FORMAT0_FULL，列表比范围少一项
+	memcpy(&t, &bin.data[tables], sizeof(t));
+	t.format_type = LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL;
+	t.data_offset = 12;
+	t.data_entries_count = t.range_length - 1;
+	t.glyph_id_start = 0;
+	errors += expect_reject("FORMAT0_FULL list shorter than its range", tables, &t, sizeof(t));
+
+	if (bin.kern) {
+		const lv_font_fmt_txt_kern_classes_t *kc = dsc->kern_dsc;
+		uint16_t map_len = (uint16_t)(bin.glyphs - 1);
+		errors += expect_reject("kern class mapping misses a glyph", bin.kern + 12, &map_len, 2);
+
+		uint8_t cls = kc->left_class_cnt + 1;
+		errors += expect_reject("left kern class out of the table", bin.kern + 16 + 1, &cls, 1);
+		cls = kc->right_class_cnt + 1;
+		errors += expect_reject("right kern class out of the table", bin.kern + 16 + bin.glyphs + 1, &cls, 1);
+	}
+	return errors;
+}
+
+int main(void) {
+	lv_init();
+	lv_disp_draw_buf_init(&draw_buf, draw_buf_1, NULL, HOR_RES * VER_RES);
+	lv_disp_drv_init(&disp_drv);
+	disp_drv.hor_res = HOR_RES;
+	disp_drv.ver_res = VER_RES;
+	disp_drv.flush_cb = flush_cb;
+	disp_drv.draw_buf = &draw_buf;
+	lv_disp_drv_register(&disp_drv);
+	fs_init();
+
+	lv_obj_t *label = lv_label_create(lv_scr_act());
+	lv_obj_set_pos(label, 2, 2);
+
+	run("ui_font_xlm_42", &ui_font_xlm_42, 16, label);
+	run("ui_font_xlm_42", &ui_font_xlm_42, 12, label);
+	run("ui_font_lcd_mono_30", &ui_font_lcd_mono_30, 16, label);
+	run("lv_font_montserrat_14", &lv_font_montserrat_14, 16, label);
+
+	int errors = run_range_ends("ui_font_xlm_42", &ui_font_xlm_42);
+	errors += run_range_ends("ui_font_lcd_mono_30", &ui_font_lcd_mono_30);
+	errors += run_range_ends("lv_font_montserrat_14", &lv_font_montserrat_14);
+	errors += run_corrupt("ui_font_xlm_42", &ui_font_xlm_42);
+	errors += run_corrupt("ui_font_lcd_mono_30", &ui_font_lcd_mono_30);
+	errors += run_corrupt("lv_font_montserrat_14", &lv_font_montserrat_14);
+	return errors ? 1 : 0;
+}
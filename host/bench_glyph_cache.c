@@ -0,0 +1,86 @@
+/**
+ * @file bench_glyph_cache.c
+ * 端口数值标签(ui_font_xlm_42, 8bpp不压缩)重绘一次的渲染耗时，以及需要从字体数据本身读取的字形字节数：
+ * 板子上字体在XIP flash里，这些字节就是每次重绘经过16KB XIP缓存的量
+ * 先不注册字体跑一遍，再用lv_font_fmt_txt_sram_cache_add注册后跑一遍
+ * PC上没有XIP，两次的耗时差别只反映查找开销；板子上的收益要看flash字节数
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "lvgl.h"
+#include "ui.h"
+
+#define HOR_RES			(240)
+#define VER_RES			(135)
+#define BENCH_REDRAWS	(2000)
+
+static lv_color_t draw_buf_1[HOR_RES * VER_RES];
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
+	LV_UNUSED(area);
+	LV_UNUSED(color_p);
+	lv_disp_flush_ready(drv);
+}
+
+static uint64_t now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+/**
+ * @brief 不走缓存时画这段文字要从字体读取的字形字节数
+ */
+static uint32_t text_glyph_bytes(const lv_font_t *font, const char *txt) {
+	uint32_t bytes = 0;
+	for (; *txt; txt++) {
+		lv_font_glyph_dsc_t g;
+		if (lv_font_get_glyph_dsc(font, &g, (uint8_t)*txt, 0)) bytes += ((uint32_t)g.box_w * g.box_h * g.bpp + 7) / 8;
+	}
+	return bytes;
+}
+
+static void run(const char *name, lv_obj_t *label, bool cached) {
+	lv_font_fmt_txt_sram_cache_stats_t s0, s1;
+	lv_font_fmt_txt_sram_cache_get_stats(&s0);
+
+	uint64_t render_ns = 0;
+	uint32_t font_bytes = 0;
+	for (uint32_t i = 0; i < BENCH_REDRAWS; i++) {
+		lv_label_set_text_fmt(label, "%04umA", (unsigned)((i * 37) % 3000));
+		if (!cached) font_bytes += text_glyph_bytes(&ui_font_xlm_42, lv_label_get_text(label));
+		uint64_t t0 = now_ns();
+		lv_refr_now(NULL);
+		render_ns += now_ns() - t0;
+	}
+
+	lv_font_fmt_txt_sram_cache_get_stats(&s1);
+	if (cached) font_bytes = s1.font_bytes - s0.font_bytes;
+	printf("%-6s render %7.2f us/redraw, glyph bytes read from the font %7.1f B/redraw, "
+		   "%u glyphs / %u B in SRAM\n", name, (double)render_ns / BENCH_REDRAWS / 1000.0,
+		   (double)font_bytes / BENCH_REDRAWS, (unsigned)s1.glyphs, (unsigned)s1.used);
+}
+
+int main(void) {
+	lv_init();
+	lv_disp_draw_buf_init(&draw_buf, draw_buf_1, NULL, HOR_RES * VER_RES);
+	lv_disp_drv_init(&disp_drv);
+	disp_drv.hor_res = HOR_RES;
+	disp_drv.ver_res = VER_RES;
+	disp_drv.flush_cb = flush_cb;
+	disp_drv.draw_buf = &draw_buf;
+	lv_disp_drv_register(&disp_drv);
+
+	lv_obj_t *label = lv_label_create(lv_scr_act());
+	lv_obj_set_style_text_font(label, &ui_font_xlm_42, LV_PART_MAIN);
+	lv_obj_set_pos(label, 8, 8);
+	lv_refr_now(NULL);
+
+	run("flash", label, false);
+	lv_font_fmt_txt_sram_cache_add(&ui_font_xlm_42);
+	run("sram", label, true);
+	return 0;
+}
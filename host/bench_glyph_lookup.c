@@ -0,0 +1,76 @@
+/**
+ * @file bench_glyph_lookup.c
+ * 仓库里用到的几个字体每秒能查多少次字形描述(lv_font_get_glyph_dsc，包括查下一个字符算字距)，
+ * 以及字形ID缓存的命中情况
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "lvgl.h"
+#include "ui.h"
+
+#define BENCH_ROUNDS	(200000)
+
+typedef struct {
+	const char *name;
+	const lv_font_t *font;
+	const char *txt;
+	const char *desc;				//打印用，NULL时直接打印txt
+} lookup_case_t;
+
+static uint64_t now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static void run(const lookup_case_t *c) {
+	//先把UTF-8解码成码点，计时只包含查找本身
+	uint32_t letters[64];
+	uint32_t cnt = 0;
+	uint32_t ofs = 0;
+	while (c->txt[ofs] != '\0' && cnt < sizeof(letters) / sizeof(letters[0]) - 1) {
+		letters[cnt++] = _lv_txt_encoded_next(c->txt, &ofs);
+	}
+	letters[cnt] = 0;
+
+#if LV_FONT_FMT_TXT_GID_CACHE_SIZE || LV_FONT_FMT_TXT_GID_ASCII
+	lv_font_fmt_txt_gid_cache_stats_t s0, s1;
+	lv_font_fmt_txt_gid_cache_get_stats(&s0);
+#endif
+
+	volatile uint32_t sink = 0;
+	uint64_t t0 = now_ns();
+	for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+		for (uint32_t i = 0; i < cnt; i++) {
+			lv_font_glyph_dsc_t g;
+			if (lv_font_get_glyph_dsc(c->font, &g, letters[i], letters[i + 1])) sink += g.adv_w;
+		}
+	}
+	uint64_t ns = now_ns() - t0;
+	double lookups = (double)BENCH_ROUNDS * cnt;
+
+	printf("%-12s %-18s %7.2f M lookups/s", c->name, c->desc ? c->desc : c->txt, lookups / ((double)ns / 1e9) / 1e6);
+#if LV_FONT_FMT_TXT_GID_CACHE_SIZE || LV_FONT_FMT_TXT_GID_ASCII
+	lv_font_fmt_txt_gid_cache_get_stats(&s1);
+	uint32_t ascii = s1.ascii_hits - s0.ascii_hits, hits = s1.hits - s0.hits, misses = s1.misses - s0.misses;
+	double total = (double)ascii + hits + misses;
+	printf("  ascii %5.1f%%  cache %5.1f%%  cmap %5.1f%%", 100.0 * ascii / total, 100.0 * hits / total,
+		   100.0 * misses / total);
+#endif
+	printf("\n");
+}
+
+int main(void) {
+	lv_init();
+
+	static const lookup_case_t cases[] = {
+		{"xlm_42", &ui_font_xlm_42, "0015mA 0230mW", NULL},
+		{"lcd_mono_30", &ui_font_lcd_mono_30, "5.02V 1.25A", NULL},
+		{"montserrat14", &lv_font_montserrat_14, "0015mA 0230mW", NULL},
+		{"montserrat14", &lv_font_montserrat_14, LV_SYMBOL_USB " 5V " LV_SYMBOL_CHARGE " " LV_SYMBOL_WARNING,
+		 "symbols + ASCII"},
+	};
+	for (uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) run(&cases[i]);
+	return 0;
+}
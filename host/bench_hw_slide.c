@@ -0,0 +1,109 @@
+/**
+ * @file bench_hw_slide.c
+ * 四个端口panel从右侧滑入：LVGL逐帧移动对象(和plenable_Animation一样) vs ui_hw_slide_in用ST7789硬件滚动，
+ * 在pico_fake上统计整个过渡的帧数、RAMWR字节数和滚动命令数
+ */
+
+#include <stdio.h>
+#include "lvgl.h"
+#include "lv_port_disp.h"
+#include "ui_hw_slide.h"
+#include "st7789.h"
+#include "pico_fake.h"
+#include "hardware/gpio.h"
+
+#define PANEL_CNT		(4)
+#define SLIDE_TIME		(500)
+
+static uint8_t last_cmd;
+static uint32_t ramwr_bytes;
+static uint32_t vscsad_cnt;
+static uint32_t frames;
+static uint8_t vscrdef[6];
+static uint32_t vscrdef_idx;
+
+static void sink(spi_inst_t *spi, uint8_t byte) {
+	(void)spi;
+	if (!gpio_get(ST7789_DC_PIN)) {
+		last_cmd = byte;
+		if (byte == ST7789_VSCSAD) vscsad_cnt++;
+		if (byte == ST7789_VSCRDEF) vscrdef_idx = 0;
+	} else if (last_cmd == ST7789_RAMWR) {
+		ramwr_bytes++;
+	} else if (last_cmd == ST7789_VSCRDEF && vscrdef_idx < sizeof(vscrdef)) {
+		vscrdef[vscrdef_idx++] = byte;
+	}
+}
+
+static void monitor_cb(lv_disp_drv_t *drv, uint32_t time, uint32_t px) {
+	LV_UNUSED(drv);
+	LV_UNUSED(time);
+	LV_UNUSED(px);
+	frames++;
+}
+
+static void set_x(void *obj, int32_t v) {
+	lv_obj_set_x(obj, (lv_coord_t)v);
+}
+
+static void run(const char *name, lv_obj_t **panels, bool hw) {
+	ramwr_bytes = 0;
+	vscsad_cnt = 0;
+	frames = 0;
+
+	for (int i = 0; i < PANEL_CNT; i++) {
+		if (hw) {
+			lv_obj_set_x(panels[i], 32);
+		} else {
+			lv_anim_t a;
+			lv_anim_init(&a);
+			lv_anim_set_var(&a, panels[i]);
+			lv_anim_set_exec_cb(&a, set_x);
+			lv_anim_set_values(&a, 220, 32);
+			lv_anim_set_time(&a, SLIDE_TIME);
+			lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+			lv_anim_start(&a);
+		}
+	}
+	if (hw && !ui_hw_slide_in(0, 239, SLIDE_TIME)) printf("%s: hardware scrolling not available\n", name);
+
+	for (uint32_t t = 0; t < SLIDE_TIME + 100; t += LV_DISP_DEF_REFR_PERIOD) {
+		lv_tick_inc(LV_DISP_DEF_REFR_PERIOD);
+		lv_timer_handler();
+	}
+
+	uint16_t vsa = (uint16_t)(vscrdef[2] << 8 | vscrdef[3]);
+	printf("%-8s %3u frames, ramwr %7u B (%6u B/frame), %3u VSCSAD, scroll area %s\n", name, (unsigned)frames,
+		   (unsigned)ramwr_bytes, (unsigned)(frames ? ramwr_bytes / frames : 0), (unsigned)vscsad_cnt,
+		   disp_slide_is_active() ? "still active" : (vsa == ST7789_GATE_LINES || !hw ? "reset" : "NOT reset"));
+}
+
+int main(void) {
+	lv_init();
+	pico_fake_set_spi_sink(sink);
+	lv_port_disp_init();
+	ui_hw_slide_set_port(disp_slide_begin, disp_slide_set);
+	lv_disp_get_default()->driver->monitor_cb = monitor_cb;
+
+	//和ui_Screen1一样的四个panel
+	lv_obj_t *scr = lv_scr_act();
+	lv_obj_set_style_bg_color(scr, lv_color_black(), LV_PART_MAIN);
+	lv_obj_t *panels[PANEL_CNT];
+	for (int i = 0; i < PANEL_CNT; i++) {
+		panels[i] = lv_obj_create(scr);
+		lv_obj_set_size(panels[i], 168, 33);
+		lv_obj_set_align(panels[i], LV_ALIGN_CENTER);
+		lv_obj_set_pos(panels[i], 220, -50 + i * 33);
+		lv_obj_set_style_bg_color(panels[i], lv_color_hex(0x00DC26), LV_PART_MAIN);
+		lv_obj_t *label = lv_label_create(panels[i]);
+		lv_label_set_text_fmt(label, "PORT%d 0000mA", i + 1);
+		lv_obj_center(label);
+	}
+	lv_refr_now(NULL);
+
+	run("lvgl", panels, false);
+	for (int i = 0; i < PANEL_CNT; i++) lv_obj_set_x(panels[i], 220);
+	lv_refr_now(NULL);
+	run("hw", panels, true);
+	return 0;
+}
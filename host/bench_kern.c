@@ -0,0 +1,123 @@
+/**
+ * @file bench_kern.c
+ * 文字宽度测量(lv_txt_get_width)的吞吐量，字距查找占了其中的一大部分
+ * lv_font_montserrat_14自带按类的字距表；再把它展开成按字形对排序的字距表(二分查找)复制一份字体，
+ * 同一份代码分别链接开/关字距查找加速的LVGL，两者的宽度校验和应当相同
+ * ASCII字距表的内存上限只够一个字体，测完第一个字体后先释放它的表
+ * 每种情况跑BENCH_RUNS次取最快的一次
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "lvgl.h"
+
+#define BENCH_ROUNDS	(20000)
+#define BENCH_RUNS		(5)
+#define MAX_PAIRS		(8192)
+
+static const char *const texts[] = {
+	"Voltage 5.012 V",
+	"Total Power 12.345 W",
+	"Port 1  0500mA 2500mW",
+	"The quick brown fox jumps over the lazy dog.",
+	"AVATAR Type Wave, LT. yo!",
+	"Temp 25.0\xC2\xB0" "C",		//°不在ASCII表里，走字形对缓存
+};
+
+static lv_font_t pair_font;
+static lv_font_fmt_txt_dsc_t pair_dsc;
+static lv_font_fmt_txt_glyph_cache_t pair_cache;
+static lv_font_fmt_txt_kern_pair_t pair_kern;
+static uint8_t pair_ids[MAX_PAIRS * 2];
+static int8_t pair_values[MAX_PAIRS];
+
+static uint64_t now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+/**
+ * @brief 把按类的字距表展开成按(左, 右)排序的字形对，字形ID都小于256
+ */
+static void make_pair_font(const lv_font_t *src) {
+	const lv_font_fmt_txt_dsc_t *dsc = src->dsc;
+	const lv_font_fmt_txt_kern_classes_t *kc = dsc->kern_dsc;
+
+	uint32_t glyphs = 1;
+	for (uint16_t i = 0; i < dsc->cmap_num; i++) {
+		const lv_font_fmt_txt_cmap_t *cmap = &dsc->cmaps[i];
+		uint32_t last = cmap->glyph_id_start + (cmap->list_length ? cmap->list_length : cmap->range_length);
+		if (last > glyphs) glyphs = last;
+	}
+
+	uint32_t cnt = 0;
+	for (uint32_t l = 1; l < glyphs && l < 256; l++) {
+		for (uint32_t r = 1; r < glyphs && r < 256; r++) {
+			uint8_t lc = kc->left_class_mapping[l], rc = kc->right_class_mapping[r];
+			if (lc == 0 || rc == 0) continue;
+			int8_t v = kc->class_pair_values[(lc - 1) * kc->right_class_cnt + (rc - 1)];
+			if (v == 0 || cnt == MAX_PAIRS) continue;
+			pair_ids[cnt * 2] = (uint8_t)l;
+			pair_ids[cnt * 2 + 1] = (uint8_t)r;
+			pair_values[cnt] = v;
+			cnt++;
+		}
+	}
+
+	pair_kern.glyph_ids = pair_ids;
+	pair_kern.values = pair_values;
+	pair_kern.pair_cnt = cnt;
+	pair_kern.glyph_ids_size = 0;
+
+	pair_dsc = *dsc;
+	pair_dsc.kern_dsc = &pair_kern;
+	pair_dsc.kern_classes = 0;
+	pair_dsc.cache = &pair_cache;
+	pair_font = *src;
+	pair_font.dsc = &pair_dsc;
+	printf("%u glyphs, %u kerning pairs\n", (unsigned)glyphs, (unsigned)cnt);
+}
+
+static void run(const char *name, const lv_font_t *font) {
+	uint32_t chars = 0, checksum = 0;
+	for (uint32_t i = 0; i < sizeof(texts) / sizeof(texts[0]); i++) chars += _lv_txt_get_encoded_length(texts[i]);
+
+	uint64_t ns = UINT64_MAX;
+	for (uint32_t run = 0; run < BENCH_RUNS; run++) {
+		checksum = 0;
+		uint64_t t0 = now_ns();
+		for (uint32_t n = 0; n < BENCH_ROUNDS; n++) {
+			for (uint32_t i = 0; i < sizeof(texts) / sizeof(texts[0]); i++) {
+				checksum += lv_txt_get_width(texts[i], strlen(texts[i]), font, 0, LV_TEXT_FLAG_NONE);
+			}
+		}
+		uint64_t t = now_ns() - t0;
+		if (t < ns) ns = t;
+	}
+
+	printf("%-8s %-9s %6.2f ns/char, %6.1f Mchar/s, width checksum %u\n", name,
+		   LV_FONT_FMT_TXT_KERN_ASCII_MEM || LV_FONT_FMT_TXT_KERN_CACHE_SIZE ? "accel" : "no accel",
+		   (double)ns / ((double)chars * BENCH_ROUNDS), (double)chars * BENCH_ROUNDS * 1000.0 / (double)ns,
+		   (unsigned)checksum);
+}
+
+int main(void) {
+	lv_init();
+	make_pair_font(&lv_font_montserrat_14);
+
+	run("classes", &lv_font_montserrat_14);
+#if LV_FONT_FMT_TXT_KERN_ASCII_MEM || LV_FONT_FMT_TXT_KERN_CACHE_SIZE
+	lv_font_fmt_txt_kern_accel_free(&lv_font_montserrat_14);
+#endif
+	run("pairs", &pair_font);
+
+#if LV_FONT_FMT_TXT_KERN_ASCII_MEM || LV_FONT_FMT_TXT_KERN_CACHE_SIZE
+	lv_font_fmt_txt_kern_stats_t s;
+	lv_font_fmt_txt_kern_get_stats(&s);
+	printf("kerning: %u ASCII table hits, %u pair cache hits, %u lookups, %u B of ASCII tables\n",
+		   (unsigned)s.ascii_hits, (unsigned)s.hits, (unsigned)s.misses, (unsigned)s.ascii_used);
+#endif
+	return 0;
+}
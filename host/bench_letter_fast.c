@@ -0,0 +1,88 @@
+/**
+ * @file bench_letter_fast.c
+ * 42px端口读数(ui_font_xlm_42, 8bpp)每次重绘的渲染耗时
+ * 同一份代码分别链接开/关LV_DRAW_SW_LETTER_FAST的LVGL，最后输出所有帧的哈希，两者应当相同
+ * 第二个标签一半在屏幕外，覆盖字形被剪切的情况
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "lvgl.h"
+#include "ui.h"
+
+#define HOR_RES			(240)
+#define VER_RES			(135)
+#define BENCH_REDRAWS	(2000)
+
+static lv_color_t draw_buf_1[HOR_RES * VER_RES];
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+
+static lv_color_t screen[HOR_RES * VER_RES];
+static uint32_t frames_hash = 2166136261u;
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
+	lv_coord_t w = lv_area_get_width(area);
+	for (lv_coord_t y = area->y1; y <= area->y2; y++) {
+		memcpy(&screen[y * HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+		color_p += w;
+	}
+	lv_disp_flush_ready(drv);
+}
+
+static uint64_t now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+/**
+ * @brief FNV-1a，把每一帧整屏的内容都累加进去
+ */
+static void hash_screen(void) {
+	const uint8_t *p = (const uint8_t *)screen;
+	for (uint32_t i = 0; i < sizeof(screen); i++) {
+		frames_hash = (frames_hash ^ p[i]) * 16777619u;
+	}
+}
+
+int main(void) {
+	lv_init();
+	lv_disp_draw_buf_init(&draw_buf, draw_buf_1, NULL, HOR_RES * VER_RES);
+	lv_disp_drv_init(&disp_drv);
+	disp_drv.hor_res = HOR_RES;
+	disp_drv.ver_res = VER_RES;
+	disp_drv.flush_cb = flush_cb;
+	disp_drv.draw_buf = &draw_buf;
+	lv_disp_drv_register(&disp_drv);
+
+	lv_obj_t *scr = lv_scr_act();
+	lv_obj_set_style_bg_color(scr, lv_color_hex(0x4FD3EA), LV_PART_MAIN);
+
+	lv_obj_t *label = lv_label_create(scr);
+	lv_obj_set_style_text_font(label, &ui_font_xlm_42, LV_PART_MAIN);
+	lv_obj_set_pos(label, 4, 8);
+
+	lv_obj_t *clipped = lv_label_create(scr);
+	lv_obj_set_style_text_font(clipped, &ui_font_xlm_42, LV_PART_MAIN);
+	lv_obj_set_style_text_color(clipped, lv_color_hex(0xBBBBBB), LV_PART_MAIN);
+	lv_obj_set_pos(clipped, 120, VER_RES - 20);
+	lv_refr_now(NULL);
+
+	uint64_t render_ns = 0;
+	for (uint32_t i = 0; i < BENCH_REDRAWS; i++) {
+		lv_label_set_text_fmt(label, "#e8e8e8 %04u#mA #bbbbbb %04u#mW", (unsigned)((i * 37) % 3000),
+							  (unsigned)((i * 53) % 9000));
+		lv_label_set_recolor(label, true);
+		lv_label_set_text_fmt(clipped, "%04u", (unsigned)(i % 10000));
+		uint64_t t0 = now_ns();
+		lv_refr_now(NULL);
+		render_ns += now_ns() - t0;
+		hash_screen();
+	}
+
+	printf("LV_DRAW_SW_LETTER_FAST=%d  render %7.2f us/redraw  frames hash %08x\n", LV_DRAW_SW_LETTER_FAST,
+		   (double)render_ns / BENCH_REDRAWS / 1000.0, (unsigned)frames_hash);
+	return 0;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file bench_panel_toggle.cpp
+ * 端口反复插拔时panel的滑入/滑出：按main.cpp的方式每500ms刷新一次四个info_label，
+ * 统计lv_obj_update_layout的调用次数，以及其中真正重新计算了布局的次数（屏幕布局已失效）；
+ * 以及插拔过程中lv_mem_alloc/lv_mem_free的次数，开始和结束时LVGL堆的碎片率
+ * BENCH_LEGACY_ENABLE=1: 原来的set_enable，每次先lv_obj_update_layout(panel)再读panel的x坐标判断是否使能
+ * BENCH_LEGACY_ENABLE=0: info_label::set_enable，由动画回调推进的状态机
+ * 链接LV_ANIM_POOL_SIZE=0编译的LVGL时，每个lv_anim_start都从堆里申请动画
+ */
+
+#include <cstdio>
+#include <algorithm>
+#include "lvgl.h"
+#include "lv_port_disp.h"
+#include "pico/time.h"
+#include "st7789_emu.h"
+#include "ui.h"
+#include "InfoLabel.h"
+
+#ifndef BENCH_LEGACY_ENABLE
+#define BENCH_LEGACY_ENABLE	0
+#endif
+
+#define FRAME_MS			(LV_DISP_DEF_REFR_PERIOD)
+#define DATA_REFRESH_INTER	(500)
+#define RUN_MS				(60000)
+#define PORT_CNT			(4)
+
+//原来的panel_is_enabled用的x坐标门限
+#define PANEL_POS_THRESHOLD	(150)
+
+static INA219_t ina219[PORT_CNT];
+static uint16_t bus_mv[PORT_CNT];
+
+static bool in_refresh;
+static uint32_t layout_calls;
+static uint32_t layout_passes;
+static uint32_t refresh_calls;
+static uint32_t refresh_passes;
+static uint32_t mem_allocs;
+static uint32_t mem_frees;
+
+extern "C" {
+
+uint16_t INA219_ReadBusVoltage(INA219_t *ina) {
+	return bus_mv[ina - ina219];
+}
+
+uint16_t INA219_ReadShuntVolage(INA219_t *ina) {
+	return static_cast<uint16_t>(bus_mv[ina - ina219] ? 300 + 200 * (ina - ina219) : 0);
+}
+
+void __real_lv_obj_update_layout(const lv_obj_t *obj);
+
+void __wrap_lv_obj_update_layout(const lv_obj_t *obj) {
+	const bool pass = lv_obj_get_screen(obj)->scr_layout_inv;
+	layout_calls++;
+	layout_passes += pass;
+	if (in_refresh) {
+		refresh_calls++;
+		refresh_passes += pass;
+	}
+	__real_lv_obj_update_layout(obj);
+}
+
+void *__real_lv_mem_alloc(size_t size);
+void __real_lv_mem_free(void *data);
+
+void *__wrap_lv_mem_alloc(size_t size) {
+	mem_allocs++;
+	return __real_lv_mem_alloc(size);
+}
+
+void __wrap_lv_mem_free(void *data) {
+	if (data) mem_frees++;
+	__real_lv_mem_free(data);
+}
+
+}
+
+#if BENCH_LEGACY_ENABLE
+/**
+ * @brief 原来的set_enable：强制刷新布局读取panel坐标，和目标状态不同就启动动画
+ */
+static void legacy_set_enable(const info_label *lb, const bool enabled) {
+	lv_obj_update_layout(lb->panel);
+	const uint32_t x = lv_obj_get_x(lb->panel);
+	const bool is_enabled = x < PANEL_POS_THRESHOLD;
+	if (is_enabled == enabled)
+		return;
+	enabled ? plenable_Animation(lb->panel, 0) : pldisable_Animation(lb->panel, 0);
+}
+#endif
+
+/**
+ * @brief 第n次刷新时各端口的总线电压：端口1一直接着，端口2每4秒、端口3每1秒插拔一次，
+ * 端口4每次刷新都切换（请求落在动画进行中）
+ */
+static void set_voltages(const uint32_t n) {
+	static const uint32_t period[PORT_CNT] = {0, 8, 2, 1};
+	for (uint32_t i = 0; i < PORT_CNT; i++) {
+		const bool plugged = period[i] == 0 || (n / period[i]) % 2 == 0;
+		bus_mv[i] = plugged ? 5100 : 0;
+	}
+}
+
+static void print_heap(const char *when, const lv_mem_monitor_t &mon) {
+	printf("  heap %-5s: %6lu B used, %2u%% fragmented, biggest free block %6lu B, %lu free blocks\n", when,
+		   static_cast<unsigned long>(mon.total_size - mon.free_size), mon.frag_pct,
+		   static_cast<unsigned long>(mon.free_biggest_size), static_cast<unsigned long>(mon.free_cnt));
+}
+
+int main() {
+	st7789_emu_init();
+	lv_init();
+	lv_port_disp_init();
+	ui_init();
+
+	info_label *labels[PORT_CNT] = {
+		new info_label(&ina219[0], uic_pl_port1, uic_lb_port1, uic_pl_shade_1, "e8e8e8", "BBBBBB", 2.7f, 1500),
+		new info_label(&ina219[1], uic_pl_port2, uic_lb_port2, uic_pl_shade_2, "e8e8e8", "BBBBBB", 2.7f, 1500),
+		new info_label(&ina219[2], uic_pl_port3, uic_lb_port3, uic_pl_shade_3, "e8e8e8", "BBBBBB", 2.7f, 1500),
+		new info_label(&ina219[3], uic_pl_port4, uic_lb_port4, uic_pl_shade_4, "e8e8e8", "BBBBBB", 2.7f, 1500),
+	};
+
+	uint32_t refreshes = 0;
+	uint32_t next_refresh = 0;
+	uint32_t frames = 0;
+	uint32_t toggles = 0;
+	uint32_t anims_peak = 0;
+	bool last[PORT_CNT] = {true, true, true, true};
+	lv_mem_monitor_t mon_start;
+	lv_mem_monitor(&mon_start);
+	const uint32_t allocs_start = mem_allocs;
+	const uint32_t frees_start = mem_frees;
+	for (uint32_t t = 0; t < RUN_MS; t += FRAME_MS) {
+		if (t >= next_refresh) {
+			next_refresh += DATA_REFRESH_INTER;
+			set_voltages(refreshes++);
+			in_refresh = true;
+			for (uint32_t i = 0; i < PORT_CNT; i++) {
+				info_label *lb = labels[i];
+				lb->refresh_sensor_data();
+				lb->update_readout();
+				lb->update_label_mask();
+				lb->update_trend();
+				const bool enabled = lb->check_voltage();
+				toggles += enabled != last[i];
+				last[i] = enabled;
+#if BENCH_LEGACY_ENABLE
+				legacy_set_enable(lb, enabled);
+#else
+				lb->set_enable(enabled);
+#endif
+			}
+			in_refresh = false;
+		}
+		sleep_ms(FRAME_MS);
+		lv_tick_inc(FRAME_MS);
+		lv_timer_handler();
+		frames++;
+		anims_peak = std::max<uint32_t>(anims_peak, lv_anim_count_running());
+	}
+
+	printf("%s, LV_ANIM_POOL_SIZE %d: %lu refreshes, %lu enable/disable toggles, %lu timer runs, "
+		   "up to %lu animations running\n",
+		   BENCH_LEGACY_ENABLE ? "legacy" : "state machine", LV_ANIM_POOL_SIZE, static_cast<unsigned long>(refreshes),
+		   static_cast<unsigned long>(toggles), static_cast<unsigned long>(frames),
+		   static_cast<unsigned long>(anims_peak));
+	printf("  lv_obj_update_layout: %lu calls (%lu layout passes), from data refresh: %lu calls (%lu layout passes)\n",
+		   static_cast<unsigned long>(layout_calls), static_cast<unsigned long>(layout_passes),
+		   static_cast<unsigned long>(refresh_calls), static_cast<unsigned long>(refresh_passes));
+	printf("  lv_mem_alloc: %lu calls, lv_mem_free: %lu calls\n", static_cast<unsigned long>(mem_allocs - allocs_start),
+		   static_cast<unsigned long>(mem_frees - frees_start));
+	lv_mem_monitor_t mon_end;
+	lv_mem_monitor(&mon_end);
+	print_heap("start", mon_start);
+	print_heap("end", mon_end);
+	return 0;
+}
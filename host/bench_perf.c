@@ -0,0 +1,49 @@
+/**
+ * @file bench_perf.c
+ * 打开LV_PORT_PERF，通过lv_timer_handler驱动刷新（lv_refr_now不经过计时），
+ * 每帧更新四个端口的数值标签，检查lv_port_perf输出的直方图和每帧的计数（像素数、flush和传输次数）
+ * pico_fake的DMA在启动时同步完成，这里的flush/overlap只反映主机上的执行时间；
+ * 帧间用sleep_ms拨动假时钟，应当全部计入idle
+ */
+
+#include <stdio.h>
+#include "lvgl.h"
+#include "lv_port_disp.h"
+#include "lv_port_perf.h"
+#include "pico/time.h"
+
+#define PORT_CNT		(4)
+#define BENCH_FRAMES	(200)
+#define FRAME_MS		(LV_DISP_DEF_REFR_PERIOD)
+
+int main(void) {
+	lv_init();
+	lv_port_disp_init();
+
+	lv_obj_t *scr = lv_scr_act();
+	lv_obj_set_style_bg_color(scr, lv_color_hex(0x00DC26), LV_PART_MAIN);
+	lv_obj_t *labels[PORT_CNT];
+	for (int i = 0; i < PORT_CNT; i++) {
+		labels[i] = lv_label_create(scr);
+		lv_obj_set_pos(labels[i], 8 + (i % 2) * 120, 8 + i * 32);
+		lv_label_set_text(labels[i], "0000mA");
+	}
+
+	for (uint32_t f = 0; f < BENCH_FRAMES; f++) {
+		for (int i = 0; i < PORT_CNT; i++) {
+			lv_label_set_text_fmt(labels[i], "%04umA", (unsigned)((f * 37 + i * 211) % 3000));
+		}
+		sleep_ms(FRAME_MS);
+		lv_tick_inc(FRAME_MS);
+		lv_timer_handler();
+	}
+
+	lv_port_perf_hist_t hist;
+	lv_port_perf_get(&hist);
+	printf("bench_perf: %lu frames left in the last window\n", (unsigned long)hist.frames);
+	//分段双缓冲每次flush发送一块
+	bool ok = hist.frames && hist.counts[LV_PORT_PERF_CNT_PX] &&
+			  hist.counts[LV_PORT_PERF_CNT_XFERS] == hist.counts[LV_PORT_PERF_CNT_FLUSHES];
+	lv_port_perf_report();
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file bench_power_gauge.c
+ * 四个端口的功率占比随电流变化时每秒的渲染耗时和刷新的像素数：
+ * power_gauge（新数值直接修改正在运行的动画，每步只重绘新旧边缘之间的竖条）
+ * vs 原来的做法（每个新数值重新启动半透明遮罩层ui_pl_shade_x的位移动画，每步重绘整块遮罩层和下面的文字）
+ * 分别按固件的500ms和150ms（动画进行中收到新数值）喂同样的电流数据
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "lvgl.h"
+#include "ui.h"
+#include "power_gauge.h"
+
+#define HOR_RES			(240)
+#define VER_RES			(135)
+#define FRAME_MS		(LV_DISP_DEF_REFR_PERIOD)
+#define PORT_CNT		(4)
+#define ANIM_TIME		(490)		//和info_label的duration相同
+#define MAX_CURRENT_MA	(1500)
+#define RUN_MS			(20000)
+
+//原来遮罩层x坐标的范围：-168完全移出panel，0完全盖住
+#define SHADE_X_EMPTY	(-168)
+#define SHADE_X_FULL	(0)
+
+static lv_color_t draw_buf_1[HOR_RES * VER_RES];
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+static uint32_t flushed_px;
+
+static lv_obj_t *shades[PORT_CNT];
+static lv_obj_t *gauges[PORT_CNT];
+static int32_t shade_x[PORT_CNT];
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
+	LV_UNUSED(color_p);
+	flushed_px += lv_area_get_size(area);
+	lv_disp_flush_ready(drv);
+}
+
+static uint64_t now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+/**
+ * @brief 伪随机的电流，两种做法喂同样的数据
+ */
+static int32_t current_at(uint32_t i, uint32_t port) {
+	return (int32_t)((i * 37u + port * 290u + (i >> 2) * 113u) % MAX_CURRENT_MA);
+}
+
+static void shade_x_cb(void *var, int32_t v) {
+	lv_obj_set_x(var, (lv_coord_t)v);
+}
+
+/**
+ * @brief 原来的set_label_mask_pos：从上一次的目标位置重新启动遮罩层的位移动画
+ */
+static void set_shade(uint32_t port, int32_t ma) {
+	int32_t x = SHADE_X_EMPTY + (SHADE_X_FULL - SHADE_X_EMPTY) * ma / MAX_CURRENT_MA;
+	lv_anim_t a;
+	lv_anim_init(&a);
+	lv_anim_set_var(&a, shades[port]);
+	lv_anim_set_exec_cb(&a, shade_x_cb);
+	lv_anim_set_values(&a, shade_x[port], x);
+	lv_anim_set_time(&a, ANIM_TIME);
+	lv_anim_set_repeat_count(&a, 0);
+	lv_anim_set_path_cb(&a, lv_anim_path_linear);
+	lv_anim_start(&a);
+	shade_x[port] = x;
+}
+
+static void set_gauge(uint32_t port, int32_t ma) {
+	power_gauge_set_value(gauges[port], ma * POWER_GAUGE_RANGE / MAX_CURRENT_MA, LV_ANIM_ON);
+}
+
+static void run(const char *name, uint32_t sample_ms, bool gauge) {
+	for (uint32_t i = 0; i < PORT_CNT; i++) {
+		lv_anim_del(shades[i], NULL);
+		lv_anim_del(gauges[i], NULL);
+		lv_obj_set_x(shades[i], SHADE_X_EMPTY);
+		shade_x[i] = SHADE_X_EMPTY;
+		power_gauge_set_value(gauges[i], 0, LV_ANIM_OFF);
+		if (gauge) {
+			lv_obj_add_flag(shades[i], LV_OBJ_FLAG_HIDDEN);
+			lv_obj_clear_flag(gauges[i], LV_OBJ_FLAG_HIDDEN);
+		} else {
+			lv_obj_clear_flag(shades[i], LV_OBJ_FLAG_HIDDEN);
+			lv_obj_add_flag(gauges[i], LV_OBJ_FLAG_HIDDEN);
+		}
+	}
+	lv_refr_now(NULL);
+
+	uint64_t update_ns = 0, render_ns = 0;
+	uint32_t samples = 0;
+	uint32_t next_sample = 0;
+	flushed_px = 0;
+	for (uint32_t t = 0; t < RUN_MS; t += FRAME_MS) {
+		uint64_t t0 = now_ns();
+		if (t >= next_sample) {
+			next_sample += sample_ms;
+			for (uint32_t i = 0; i < PORT_CNT; i++) {
+				int32_t ma = current_at(samples, i);
+				gauge ? set_gauge(i, ma) : set_shade(i, ma);
+			}
+			samples++;
+		}
+		uint64_t t1 = now_ns();
+		lv_tick_inc(FRAME_MS);
+		lv_timer_handler();
+		uint64_t t2 = now_ns();
+		update_ns += t1 - t0;
+		render_ns += t2 - t1;
+	}
+
+	uint32_t secs = RUN_MS / 1000;
+	printf("%-12s every %3u ms: update %6.1f us/s  render %8.1f us/s  flushed %6u px/s\n", name,
+		   (unsigned)sample_ms, (double)update_ns / secs / 1000.0, (double)render_ns / secs / 1000.0,
+		   (unsigned)(flushed_px / secs));
+}
+
+int main(void) {
+	lv_init();
+	lv_disp_draw_buf_init(&draw_buf, draw_buf_1, NULL, HOR_RES * VER_RES);
+	lv_disp_drv_init(&disp_drv);
+	disp_drv.hor_res = HOR_RES;
+	disp_drv.ver_res = VER_RES;
+	disp_drv.flush_cb = flush_cb;
+	disp_drv.draw_buf = &draw_buf;
+	lv_disp_drv_register(&disp_drv);
+
+	ui_init();
+	//等开机的滑入动画结束
+	for (uint32_t t = 0; t < 3000; t += FRAME_MS) {
+		lv_tick_inc(FRAME_MS);
+		lv_timer_handler();
+	}
+
+	lv_obj_t *panels[PORT_CNT] = {ui_pl_port1, ui_pl_port2, ui_pl_port3, ui_pl_port4};
+	lv_obj_t *shade_objs[PORT_CNT] = {ui_pl_shade_1, ui_pl_shade_2, ui_pl_shade_3, ui_pl_shade_4};
+	lv_obj_t *labels[PORT_CNT] = {ui_lb_port1, ui_lb_port2, ui_lb_port3, ui_lb_port4};
+	for (uint32_t i = 0; i < PORT_CNT; i++) {
+		shades[i] = shade_objs[i];
+		//和info_label一样由遮罩层确定占比条的大小和颜色，占比条画在文字下面
+		gauges[i] = power_gauge_create(panels[i]);
+		lv_obj_set_align(gauges[i], lv_obj_get_style_align(shades[i], LV_PART_MAIN));
+		lv_obj_set_size(gauges[i], lv_obj_get_style_width(shades[i], LV_PART_MAIN),
+						lv_obj_get_style_height(shades[i], LV_PART_MAIN));
+		power_gauge_set_shade(gauges[i], lv_obj_get_style_bg_color(shades[i], LV_PART_MAIN),
+							  lv_obj_get_style_bg_opa(shades[i], LV_PART_MAIN));
+		power_gauge_set_anim_time(gauges[i], ANIM_TIME);
+		lv_obj_move_to_index(gauges[i], lv_obj_get_index(labels[i]));
+	}
+
+	run("shade", 500, false);
+	run("power_gauge", 500, true);
+	run("shade", 150, false);
+	run("power_gauge", 150, true);
+	return 0;
+}
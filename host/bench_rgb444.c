@@ -0,0 +1,168 @@
+/**
+ * @file bench_rgb444.c
+ * 12位总线：ST7789_ConvertRGB444的转换速度和正确性，以及通过lv_port_disp整屏刷新一帧时SPI线上的位数；
+ * 用st7789_emu逐像素检查屏幕上显示的颜色：lv_port_disp刷新的整屏，以及DMA队列发送的连续和跨步图像
+ * 同一份代码分别按ST7789_BUS_BPP=16和12编译，总线时间按62.5MHz的SPI时钟估算
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "lvgl.h"
+#include "lv_port_disp.h"
+#include "st7789.h"
+#include "st7789_emu.h"
+#include "pico_fake.h"
+
+#define SPI_HZ			(62500000.0)
+#define BAND_PX			(240 * 45)
+#define CONVERT_LOOPS	(2000)
+#define BENCH_FRAMES	(20)
+#define IMG_W			(24)
+#define IMG_H			(16)
+
+static uint16_t model[ST7789_HEIGHT][ST7789_WIDTH];
+static void (*port_flush)(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p);
+
+static uint64_t now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+/**
+ * @brief 显存里保存的颜色：12位总线上只有RGB444，st7789_emu再扩展回RGB565
+ */
+static uint16_t shown_color(uint16_t c) {
+#if ST7789_BUS_BPP == 12
+	uint16_t px = ST7789_RGB444(c);
+	uint16_t r = (px >> 8) & 0xF, g = (px >> 4) & 0xF, b = px & 0xF;
+	return (uint16_t)((r << 1 | r >> 3) << 11 | (g << 2 | g >> 2) << 5 | (b << 1 | b >> 3));
+#else
+	return c;
+#endif
+}
+
+/**
+ * @brief 在lv_port_disp转换和发送之前记下LVGL画出的颜色（LV_COLOR_16_SWAP，高字节在前）
+ */
+static void model_flush(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
+	const lv_color_t *px = color_p;
+	for (lv_coord_t y = area->y1; y <= area->y2; y++) {
+		for (lv_coord_t x = area->x1; x <= area->x2; x++, px++) {
+			uint16_t c = px->full;
+			model[y][x] = shown_color((uint16_t)(c << 8 | c >> 8));
+		}
+	}
+	port_flush(drv, area, color_p);
+}
+
+static uint32_t check(uint16_t x0, uint16_t y0, uint16_t w, uint16_t h) {
+	uint32_t mismatches = 0;
+	for (uint16_t y = y0; y < y0 + h; y++) {
+		for (uint16_t x = x0; x < x0 + w; x++) {
+			if (st7789_emu_get_pixel(x, y) != model[y][x]) mismatches++;
+		}
+	}
+	return mismatches;
+}
+
+/**
+ * @brief 不经过LVGL直接把RGB565的色块按总线格式排队发送：先发整块，再从更宽的图像里跨步发送同样的色块
+ */
+static int bench_queue(void) {
+	static const uint16_t colors[] = {RED, GREEN, BLUE, WHITE, YELLOW, MAGENTA};
+	static uint16_t block[IMG_H][IMG_W];
+	static uint16_t img[IMG_H][IMG_W * 2];
+	for (uint16_t y = 0; y < IMG_H; y++) {
+		for (uint16_t x = 0; x < IMG_W * 2; x++) {
+			uint16_t c = colors[(x / 4 + y / 8) % (sizeof(colors) / sizeof(colors[0]))];
+#if ST7789_BUS_BPP == 12
+			img[y][x] = ST7789_RGB444(c);
+#else
+			img[y][x] = (uint16_t)(c << 8 | c >> 8);
+#endif
+			if (x < IMG_W) {
+				block[y][x] = img[y][x];
+				model[y][x] = shown_color(c);
+				model[y + IMG_H][x] = shown_color(c);
+			}
+		}
+	}
+	ST7789_QueueImage(0, 0, IMG_W, IMG_H, &block[0][0]);
+	ST7789_QueueImageStrided(0, IMG_H, IMG_W, IMG_H, &img[0][0], IMG_W * 2);
+	uint32_t bad = check(0, 0, IMG_W, IMG_H * 2);
+	printf("queued image: %u pixels wrong\n", (unsigned)bad);
+	return bad ? 1 : 0;
+}
+
+#if ST7789_BUS_BPP == 12
+static uint16_t band[BAND_PX + 1];
+
+/**
+ * @brief 和逐像素先交换字节再用ST7789_RGB444的结果比较，顺带测转换速度
+ */
+static int bench_convert(void) {
+	int bad = 0;
+	//从奇数地址开始，覆盖头尾不成对的像素
+	uint16_t *buf = band + 1;
+	for (uint32_t i = 0; i < BAND_PX; i++) buf[i] = (uint16_t)(i * 2654435761u >> 16);
+	for (uint32_t i = 0; i < BAND_PX - 1; i++) {
+		uint16_t c = (uint16_t)(buf[i] << 8 | buf[i] >> 8);
+		uint16_t expect = ST7789_RGB444(c);
+		ST7789_ConvertRGB444(&buf[i], 1);
+		if (buf[i] != expect) bad++;
+	}
+
+	uint64_t t0 = now_ns();
+	for (uint32_t n = 0; n < CONVERT_LOOPS; n++) ST7789_ConvertRGB444(buf, BAND_PX - 1);
+	uint64_t t1 = now_ns();
+	double mpx_s = (double)(BAND_PX - 1) * CONVERT_LOOPS / ((double)(t1 - t0) / 1e9) / 1e6;
+	printf("convert: %.0f Mpx/s on host, %d mismatches\n", mpx_s, bad);
+	return bad;
+}
+#endif
+
+int main(void) {
+	int errors = 0;
+#if ST7789_BUS_BPP == 12
+	errors += bench_convert();
+#endif
+
+	st7789_emu_init();
+	lv_init();
+	lv_port_disp_init();
+	lv_disp_drv_t *drv = lv_disp_get_default()->driver;
+	port_flush = drv->flush_cb;
+	drv->flush_cb = model_flush;
+
+	lv_obj_t *scr = lv_scr_act();
+	lv_obj_set_style_bg_color(scr, lv_color_hex(0x202020), LV_PART_MAIN);
+	lv_obj_t *label = lv_label_create(scr);
+	lv_label_set_text(label, "12.345 V\n6.789 W");
+	lv_obj_center(label);
+	lv_refr_now(NULL);
+
+	pico_fake_reset_stats();
+	st7789_emu_reset_stats();
+	uint64_t t0 = now_ns();
+	for (uint32_t f = 0; f < BENCH_FRAMES; f++) {
+		lv_obj_invalidate(scr);
+		lv_refr_now(NULL);
+	}
+	uint64_t t1 = now_ns();
+
+	uint32_t px = 240 * 135;
+	uint32_t bits = pico_fake_stats.bus_bits / BENCH_FRAMES;
+	uint32_t expect = px * ST7789_BUS_BPP / 8;
+	uint32_t ramwr_bytes = st7789_emu_stats.ramwr_bytes;
+	uint32_t bad = check(0, 0, ST7789_WIDTH, ST7789_HEIGHT);
+	if (ramwr_bytes / BENCH_FRAMES != expect) errors++;
+	if (bad) errors++;
+	printf("%2d-bit: %6u B ramwr/frame (expect %u), %7u bits on bus/frame, bus %.2f ms/frame @62.5MHz, "
+		   "host frame %.0f us, %u pixels wrong\n", ST7789_BUS_BPP, (unsigned)(ramwr_bytes / BENCH_FRAMES),
+		   (unsigned)expect, (unsigned)bits, bits / SPI_HZ * 1e3, (double)(t1 - t0) / BENCH_FRAMES / 1e3,
+		   (unsigned)bad);
+
+	errors += bench_queue();
+	return errors ? 1 : 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file bench_sparkline.c
+ * 比较240px宽的趋势线每加入一个新点的渲染耗时：
+ * sparkline（左移一列+画最新一列） vs lv_chart（每次重画整条折线）
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "lvgl.h"
+#include "sparkline.h"
+
+#define HOR_RES			(240)
+#define VER_RES			(135)
+#define TREND_W			(240)
+#define TREND_H			(33)
+#define WARMUP_SAMPLES	(TREND_W)
+#define BENCH_SAMPLES	(2000)
+
+static lv_color_t draw_buf_1[HOR_RES * VER_RES];
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+static uint32_t flushed_px;
+
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
+	LV_UNUSED(color_p);
+	flushed_px += lv_area_get_size(area);
+	lv_disp_flush_ready(drv);
+}
+
+static uint64_t now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+/**
+ * @brief 伪随机的电流波形，两种控件喂同样的数据
+ */
+static int32_t sample_at(uint32_t i) {
+	return (int32_t)((i * 37u + (i >> 3) * 11u) % 1500u);
+}
+
+typedef void (*push_fn_t)(lv_obj_t *obj, lv_chart_series_t *ser, int32_t value);
+
+static void push_sparkline(lv_obj_t *obj, lv_chart_series_t *ser, int32_t value) {
+	LV_UNUSED(ser);
+	sparkline_add_sample(obj, value);
+}
+
+static void push_chart(lv_obj_t *obj, lv_chart_series_t *ser, int32_t value) {
+	lv_chart_set_next_value(obj, ser, value);
+}
+
+static void run(const char *name, lv_obj_t *obj, lv_chart_series_t *ser, push_fn_t push) {
+	for (uint32_t i = 0; i < WARMUP_SAMPLES; i++) {
+		push(obj, ser, sample_at(i));
+		lv_refr_now(NULL);
+	}
+
+	uint64_t update_ns = 0, render_ns = 0;
+	flushed_px = 0;
+	for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+		uint64_t t0 = now_ns();
+		push(obj, ser, sample_at(WARMUP_SAMPLES + i));
+		uint64_t t1 = now_ns();
+		lv_refr_now(NULL);
+		uint64_t t2 = now_ns();
+		update_ns += t1 - t0;
+		render_ns += t2 - t1;
+	}
+
+	printf("%-10s update %7.2f us  render %7.2f us  flushed %5u px/sample\n", name,
+		   (double)update_ns / BENCH_SAMPLES / 1000.0, (double)render_ns / BENCH_SAMPLES / 1000.0,
+		   (unsigned)(flushed_px / BENCH_SAMPLES));
+}
+
+int main(void) {
+	lv_init();
+	lv_disp_draw_buf_init(&draw_buf, draw_buf_1, NULL, HOR_RES * VER_RES);
+	lv_disp_drv_init(&disp_drv);
+	disp_drv.hor_res = HOR_RES;
+	disp_drv.ver_res = VER_RES;
+	disp_drv.flush_cb = flush_cb;
+	disp_drv.draw_buf = &draw_buf;
+	lv_disp_drv_register(&disp_drv);
+
+	lv_obj_t *scr = lv_scr_act();
+	lv_obj_set_style_bg_color(scr, lv_color_hex(0x00DC26), LV_PART_MAIN);
+
+	lv_obj_t *spark = sparkline_create(scr);
+	lv_obj_set_size(spark, TREND_W, TREND_H);
+	sparkline_set_range(spark, 0, 1500);
+	sparkline_set_line_color(spark, lv_color_hex(0x005810));
+	lv_refr_now(NULL);
+	run("sparkline", spark, NULL, push_sparkline);
+	lv_obj_del(spark);
+
+	lv_obj_t *chart = lv_chart_create(scr);
+	lv_obj_set_size(chart, TREND_W, TREND_H);
+	lv_obj_set_style_bg_opa(chart, LV_OPA_TRANSP, LV_PART_MAIN);
+	lv_obj_set_style_border_width(chart, 0, LV_PART_MAIN);
+	lv_obj_set_style_pad_all(chart, 0, LV_PART_MAIN);
+	lv_obj_set_style_size(chart, 0, LV_PART_INDICATOR);
+	lv_chart_set_div_line_count(chart, 0, 0);
+	lv_chart_set_point_count(chart, TREND_W);
+	lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, 0, 1500);
+	lv_chart_set_update_mode(chart, LV_CHART_UPDATE_MODE_SHIFT);
+	lv_chart_series_t *ser = lv_chart_add_series(chart, lv_color_hex(0x005810), LV_CHART_AXIS_PRIMARY_Y);
+	lv_refr_now(NULL);
+	run("lv_chart", chart, ser, push_chart);
+
+	return 0;
+}
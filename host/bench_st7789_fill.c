@@ -0,0 +1,71 @@
+/**
+ * @file bench_st7789_fill.c
+ * 在pico_fake上运行ST7789_Fill_Color/ST7789_Fill，统计SPI/DMA的传输次数、字节数和CS翻转次数，
+ * 并检查RAMWR之后送出的每个像素是否都是填充色
+ */
+
+#include <stdio.h>
+#include "st7789.h"
+#include "pico_fake.h"
+#include "hardware/gpio.h"
+#include "hardware/dma.h"
+
+static uint8_t last_cmd;
+static uint32_t ramwr_bytes;
+static uint32_t bad_bytes;
+static uint16_t expect_color;
+
+void dma_start_handler(void) {
+}
+
+void dma_handler(void) {
+}
+
+static void sink(spi_inst_t *spi, uint8_t byte) {
+	(void)spi;
+	if (!gpio_get(ST7789_DC_PIN)) {
+		last_cmd = byte;
+		return;
+	}
+	if (last_cmd != ST7789_RAMWR) return;
+
+	uint8_t expect = (ramwr_bytes & 1) ? (uint8_t)expect_color : (uint8_t)(expect_color >> 8);
+	if (byte != expect) bad_bytes++;
+	ramwr_bytes++;
+}
+
+static void run(const char *name, uint16_t color, uint32_t px, void (*fill)(uint16_t color)) {
+	pico_fake_reset_stats();
+	ramwr_bytes = 0;
+	bad_bytes = 0;
+	expect_color = color;
+
+	fill(color);
+
+	printf("%-12s %6u px: spi calls %5u (%6u B), dma starts %3u (%6u B), irqs %u, cs edges %5u, "
+		   "ramwr %6u B, bad %u%s\n",
+		   name, (unsigned)px, (unsigned)pico_fake_stats.spi_calls, (unsigned)pico_fake_stats.spi_bytes,
+		   (unsigned)pico_fake_stats.dma_starts, (unsigned)pico_fake_stats.dma_bytes,
+		   (unsigned)pico_fake_stats.dma_irqs, (unsigned)pico_fake_stats.gpio_edges[ST7789_CS_PIN],
+		   (unsigned)ramwr_bytes, (unsigned)bad_bytes, ramwr_bytes == px * 2 && bad_bytes == 0 ? "" : "  MISMATCH");
+}
+
+static void fill_screen(uint16_t color) {
+	ST7789_Fill_Color(color);
+}
+
+static void fill_rect(uint16_t color) {
+	ST7789_Fill(10, 20, 109, 69, color);
+}
+
+int main(void) {
+	pico_fake_set_spi_sink(sink);
+
+	//和lv_port_disp一样：先初始化（此时还没有DMA通道，走阻塞SPI），再申请DMA通道
+	ST7789_Init();
+	DmaChann = dma_claim_unused_channel(true);
+
+	run("Fill_Color", RED, ST7789_WIDTH * ST7789_HEIGHT, fill_screen);
+	run("Fill", BLUE, 100 * 50, fill_rect);
+	return 0;
+}
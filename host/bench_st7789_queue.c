@@ -0,0 +1,73 @@
+/**
+ * @file bench_st7789_queue.c
+ * 在pico_fake上通过ST7789_DrawImage发送几块图像，检查每次传输的命令顺序、CS翻转和完成回调次数，
+ * 并打印驱动统计的每次传输CPU时间
+ */
+
+#include <stdio.h>
+#include "st7789.h"
+#include "pico_fake.h"
+#include "hardware/gpio.h"
+#include "hardware/dma.h"
+
+#define IMG_W		(156)
+#define IMG_H		(35)
+#define IMG_CNT		(4)
+
+static uint16_t img[IMG_W * IMG_H];
+static uint32_t finished;
+
+/*按字节记录每次传输：命令序列（只保存前16个）和RAMWR之后的数据量*/
+static uint8_t cmds[16];
+static uint32_t cmd_cnt;
+static uint32_t ramwr_bytes;
+
+void dma_start_handler(void) {
+}
+
+void dma_handler(void) {
+	finished++;
+}
+
+static void sink(spi_inst_t *spi, uint8_t byte) {
+	(void)spi;
+	if (!gpio_get(ST7789_DC_PIN)) {
+		if (cmd_cnt < sizeof(cmds)) cmds[cmd_cnt] = byte;
+		cmd_cnt++;
+	} else if (cmd_cnt && cmd_cnt <= sizeof(cmds) && cmds[cmd_cnt - 1] == ST7789_RAMWR) {
+		ramwr_bytes++;
+	}
+}
+
+int main(void) {
+	pico_fake_set_spi_sink(sink);
+	ST7789_Init();
+	DmaChann = dma_claim_unused_channel(true);
+	cmd_cnt = 0;
+
+	for (uint32_t i = 0; i < IMG_W * IMG_H; i++) img[i] = (uint16_t)i;
+
+	int errors = 0;
+	for (int n = 0; n < IMG_CNT; n++) {
+		pico_fake_reset_stats();
+		cmd_cnt = 0;
+		ramwr_bytes = 0;
+
+		ST7789_DrawImage(32, (uint16_t)(n * 33), IMG_W, IMG_H, img);
+
+		bool ok = cmd_cnt == 3 && cmds[0] == ST7789_CASET && cmds[1] == ST7789_RASET && cmds[2] == ST7789_RAMWR &&
+				  ramwr_bytes == sizeof(img) && pico_fake_stats.gpio_edges[ST7789_CS_PIN] == 2 &&
+				  pico_fake_stats.dma_starts == 1 && pico_fake_stats.dma_irqs == 1 && finished == (uint32_t)n + 1;
+		if (!ok) errors++;
+		printf("image %d: cmds %u, ramwr %u B, cs edges %u, dma starts %u, irqs %u, spi calls %u%s\n", n,
+			   (unsigned)cmd_cnt, (unsigned)ramwr_bytes, (unsigned)pico_fake_stats.gpio_edges[ST7789_CS_PIN],
+			   (unsigned)pico_fake_stats.dma_starts, (unsigned)pico_fake_stats.dma_irqs,
+			   (unsigned)pico_fake_stats.spi_calls, ok ? "" : "  MISMATCH");
+	}
+
+	ST7789_QueueStats stats;
+	ST7789_GetQueueStats(&stats);
+	printf("queue: %u images, driver cpu %.2f us/image (max %u us)\n", (unsigned)stats.xfers,
+		   stats.xfers ? (double)stats.cpu_us_total / stats.xfers : 0.0, (unsigned)stats.cpu_us_max);
+	return errors ? 1 : 0;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file bench_st7789_text.c
+ * 不依赖LVGL的文字输出(ST7789_WriteString/ST7789_WriteChar)：用st7789_emu逐像素检查换行、裁剪和颜色，
+ * 统计每行文字的窗口数、SPI/DMA传输次数和总线字节数
+ * 对照：逐像素ST7789_DrawPixel（原来的驱动画文字的方式）
+ * 先在申请DMA通道之前画一遍（lv_init之前的启动信息），再申请DMA通道画一遍
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "st7789.h"
+#include "st7789_emu.h"
+#include "pico_fake.h"
+#include "hardware/dma.h"
+
+typedef void (*put_pixel_t)(uint16_t x, uint16_t y, uint16_t color);
+
+static uint16_t model[ST7789_HEIGHT][ST7789_WIDTH];
+
+static const char *const fault_text = "HardFault\nPC  0x10004f2a\nLR  0x10003c11\nxPSR 0x61000000\n\x01 stack overflow?";
+
+void dma_start_handler(void) {
+}
+
+void dma_handler(void) {
+}
+
+/**
+ * @brief 和驱动相同的排版规则逐像素画一个字符串，返回画了几行文字
+ */
+static uint32_t layout(uint16_t x, uint16_t y, const char *str, const FontDef *font, uint16_t color,
+					   uint16_t bgcolor, put_pixel_t put) {
+	uint32_t lines = 0;
+	while (*str && y < ST7789_HEIGHT) {
+		bool drawn = false;
+		while (*str && *str != '\n' && x + font->width <= ST7789_WIDTH) {
+			uint8_t ch = (uint8_t)*str++;
+			if (ch < ' ' || ch > '~') ch = '?';
+			for (uint16_t row = 0; row < font->height && y + row < ST7789_HEIGHT; row++) {
+				uint16_t bits = font->data[(ch - ' ') * font->height + row];
+				for (uint16_t col = 0; col < font->width; col++) {
+					put(x + col, y + row, (bits << col) & 0x8000 ? color : bgcolor);
+				}
+			}
+			x += font->width;
+			drawn = true;
+		}
+		if (*str == '\n') str++;
+		if (drawn) lines++;
+		x = 0;
+		y += font->height;
+	}
+	return lines;
+}
+
+/**
+ * @brief 显存里保存的颜色：12位总线上只有RGB444，st7789_emu再扩展回RGB565
+ */
+static uint16_t shown_color(uint16_t c) {
+#if ST7789_BUS_BPP == 12
+	uint16_t px = ST7789_RGB444(c);
+	uint16_t r = (px >> 8) & 0xF, g = (px >> 4) & 0xF, b = px & 0xF;
+	return (uint16_t)((r << 1 | r >> 3) << 11 | (g << 2 | g >> 2) << 5 | (b << 1 | b >> 3));
+#else
+	return c;
+#endif
+}
+
+static void put_model(uint16_t x, uint16_t y, uint16_t color) {
+	model[y][x] = shown_color(color);
+}
+
+static void put_draw_pixel(uint16_t x, uint16_t y, uint16_t color) {
+	ST7789_DrawPixel(x, y, color);
+}
+
+static uint32_t check(void) {
+	uint32_t mismatches = 0;
+	for (uint16_t y = 0; y < ST7789_HEIGHT; y++) {
+		for (uint16_t x = 0; x < ST7789_WIDTH; x++) {
+			if (st7789_emu_get_pixel(x, y) != model[y][x]) mismatches++;
+		}
+	}
+	return mismatches;
+}
+
+static int run(const char *name, uint16_t x, uint16_t y, const char *str, const FontDef *font, bool per_pixel) {
+	ST7789_Fill_Color(BLACK);
+	memset(model, 0, sizeof(model));
+	uint32_t lines = layout(x, y, str, font, YELLOW, BLUE, put_model);
+
+	st7789_emu_reset_stats();
+	pico_fake_reset_stats();
+	if (per_pixel) {
+		layout(x, y, str, font, YELLOW, BLUE, put_draw_pixel);
+	} else {
+		ST7789_WriteString(x, y, str, *font, YELLOW, BLUE);
+	}
+
+	uint32_t xfers = pico_fake_stats.spi_calls + pico_fake_stats.dma_starts;
+	uint32_t per = lines ? lines : 1;
+	uint32_t mismatches = check();
+	printf("%-10s %2ux%-2u %-9s: %u lines, per line %5u windows %6u xfers (%4u DMA) %7u B, %u pixels wrong\n", name,
+		   font->width, font->height, per_pixel ? "DrawPixel" : "text", (unsigned)lines,
+		   (unsigned)(st7789_emu_stats.windows / per), (unsigned)(xfers / per),
+		   (unsigned)(pico_fake_stats.dma_starts / per), (unsigned)(st7789_emu_stats.bytes / per), (unsigned)mismatches);
+	return mismatches ? 1 : 0;
+}
+
+static int run_all(const char *stage) {
+	static const FontDef *const fonts[] = {&Font_7x10, &Font_11x18, &Font_16x26};
+	int errors = 0;
+	printf("-- %s --\n", stage);
+	for (uint8_t i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++) {
+		errors += run("status", 0, 0, "VBUS 5.12V", fonts[i], true);
+		errors += run("status", 0, 0, "VBUS 5.12V", fonts[i], false);
+		errors += run("fault", 3, 5, fault_text, fonts[i], false);
+	}
+	//右边放不下的字符整个不画，底部超出屏幕的部分裁掉
+	errors += run("edge", ST7789_WIDTH - 15, ST7789_HEIGHT - 12, "AB", &Font_11x18, false);
+	return errors;
+}
+
+int main(void) {
+	st7789_emu_init();
+	ST7789_Init();
+
+	int errors = run_all("before DMA");
+
+	DmaChann = dma_claim_unused_channel(true);
+	errors += run_all("DMA");
+
+	//故障处理：队列里还有图像时接管屏幕
+	static uint16_t img[16 * 16];
+	ST7789_QueueImage(0, 0, 16, 16, img);
+	ST7789_AbortQueue();
+	errors += run("abort", 0, 0, fault_text, &Font_7x10, false);
+	return errors ? 1 : 0;
+}
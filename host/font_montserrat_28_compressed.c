@@ -0,0 +1,10 @@
+/**
+ * @file font_montserrat_28_compressed.c
+ * lv_conf.h里没有打开LVGL自带的压缩字体，给基准测试单独编译一份
+ */
+
+#include "lvgl.h"
+
+#undef LV_FONT_MONTSERRAT_28_COMPRESSED
+#define LV_FONT_MONTSERRAT_28_COMPRESSED 1
+#include "src/font/lv_font_montserrat_28_compressed.c"
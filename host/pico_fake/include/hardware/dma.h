@@ -0,0 +1,100 @@
+/**
+ * @file dma.h
+ * DMA在触发时立即同步完成，完成中断也在触发处同步调用
+ * 寄存器都是uintptr_t宽，这样在64位主机上控制块也能直接写入读地址；
+ * 目标是DMA寄存器的传输按uintptr_t一个元素处理，不管配置的传输宽度
+ */
+
+#ifndef PICO_FAKE_DMA_H
+#define PICO_FAKE_DMA_H
+
+#include "pico.h"
+#include "hardware/irq.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NUM_DMA_CHANNELS	12
+
+enum dma_channel_transfer_size {
+	DMA_SIZE_8 = 0,
+	DMA_SIZE_16 = 1,
+	DMA_SIZE_32 = 2,
+};
+
+typedef uintptr_t io_rw_32;
+
+typedef struct {
+	io_rw_32 read_addr;
+	io_rw_32 write_addr;
+	io_rw_32 transfer_count;
+	io_rw_32 ctrl_trig;
+	io_rw_32 al1_ctrl;
+	io_rw_32 al1_read_addr;
+	io_rw_32 al1_write_addr;
+	io_rw_32 al1_transfer_count_trig;
+	io_rw_32 al2_ctrl;
+	io_rw_32 al2_transfer_count;
+	io_rw_32 al2_read_addr;
+	io_rw_32 al2_write_addr_trig;
+	io_rw_32 al3_ctrl;
+	io_rw_32 al3_write_addr;
+	io_rw_32 al3_transfer_count;
+	io_rw_32 al3_read_addr_trig;
+} dma_channel_hw_t;
+
+typedef struct {
+	dma_channel_hw_t ch[NUM_DMA_CHANNELS];
+} dma_hw_t;
+
+extern dma_hw_t *const dma_hw;
+
+typedef struct {
+	enum dma_channel_transfer_size size;
+	bool read_increment;
+	bool write_increment;
+	bool bswap;
+	bool irq_quiet;
+	uint dreq;
+	uint chain_to;
+	bool ring_sel;			//true: 写地址回绕
+	uint ring_size_bits;	//0: 不回绕
+} dma_channel_config;
+
+dma_channel_config dma_channel_get_default_config(uint channel);
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size);
+void channel_config_set_read_increment(dma_channel_config *c, bool incr);
+void channel_config_set_write_increment(dma_channel_config *c, bool incr);
+void channel_config_set_dreq(dma_channel_config *c, uint dreq);
+void channel_config_set_bswap(dma_channel_config *c, bool bswap);
+void channel_config_set_chain_to(dma_channel_config *c, uint chain_to);
+void channel_config_set_irq_quiet(dma_channel_config *c, bool irq_quiet);
+void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits);
+
+dma_channel_hw_t *dma_channel_hw_addr(uint channel);
+
+int dma_claim_unused_channel(bool required);
+void dma_channel_unclaim(uint channel);
+bool dma_channel_is_claimed(uint channel);
+void dma_channel_cleanup(uint channel);
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+						   const volatile void *read_addr, uint transfer_count, bool trigger);
+void dma_channel_set_config(uint channel, const dma_channel_config *config, bool trigger);
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger);
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger);
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger);
+void dma_channel_start(uint channel);
+bool dma_channel_is_busy(uint channel);
+void dma_channel_wait_for_finish_blocking(uint channel);
+void dma_channel_abort(uint channel);
+
+void dma_channel_set_irq0_enabled(uint channel, bool enabled);
+void dma_channel_acknowledge_irq0(uint channel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PICO_FAKE_DMA_H
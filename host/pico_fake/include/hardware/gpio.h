@@ -0,0 +1,36 @@
+/**
+ * @file gpio.h
+ *
+ */
+
+#ifndef PICO_FAKE_GPIO_H
+#define PICO_FAKE_GPIO_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GPIO_OUT	1
+#define GPIO_IN		0
+
+enum gpio_function {
+	GPIO_FUNC_SPI = 1,
+	GPIO_FUNC_UART = 2,
+	GPIO_FUNC_I2C = 3,
+	GPIO_FUNC_SIO = 5,
+};
+
+void gpio_init(uint gpio);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_put(uint gpio, bool value);
+bool gpio_get(uint gpio);
+void gpio_set_function(uint gpio, enum gpio_function fn);
+void gpio_pull_up(uint gpio);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PICO_FAKE_GPIO_H
@@ -0,0 +1,21 @@
+/**
+ * @file i2c.h
+ * 只提供INA219.h用到的类型，主机上的基准测试自己提供INA219的读数函数
+ */
+
+#ifndef PICO_FAKE_I2C_H
+#define PICO_FAKE_I2C_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct i2c_inst i2c_inst_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PICO_FAKE_I2C_H
@@ -0,0 +1,27 @@
+/**
+ * @file irq.h
+ *
+ */
+
+#ifndef PICO_FAKE_IRQ_H
+#define PICO_FAKE_IRQ_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DMA_IRQ_0	11
+#define DMA_IRQ_1	12
+
+typedef void (*irq_handler_t)(void);
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler);
+void irq_set_enabled(uint num, bool enabled);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PICO_FAKE_IRQ_H
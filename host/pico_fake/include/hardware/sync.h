@@ -0,0 +1,19 @@
+/**
+ * @file sync.h
+ * 假中断都是在触发处同步调用的，开关中断不需要做任何事
+ */
+
+#ifndef PICO_FAKE_SYNC_H
+#define PICO_FAKE_SYNC_H
+
+#include "pico.h"
+
+static inline uint32_t save_and_disable_interrupts(void) {
+	return 0;
+}
+
+static inline void restore_interrupts(uint32_t status) {
+	(void)status;
+}
+
+#endif //PICO_FAKE_SYNC_H
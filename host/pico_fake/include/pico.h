@@ -0,0 +1,25 @@
+/**
+ * @file pico.h
+ *
+ */
+
+#ifndef PICO_FAKE_PICO_H
+#define PICO_FAKE_PICO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef unsigned int uint;
+
+static inline void tight_loop_contents(void) {}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PICO_FAKE_PICO_H
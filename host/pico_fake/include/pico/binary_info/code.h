@@ -0,0 +1,9 @@
+/**
+ * @file code.h
+ *
+ */
+
+#ifndef PICO_FAKE_BINARY_INFO_CODE_H
+#define PICO_FAKE_BINARY_INFO_CODE_H
+
+#endif //PICO_FAKE_BINARY_INFO_CODE_H
@@ -0,0 +1,23 @@
+/**
+ * @file stdlib.h
+ * pico_fake：在PC上代替Pico SDK的最小头文件集合，只声明本仓库用到的接口
+ */
+
+#ifndef PICO_FAKE_STDLIB_H
+#define PICO_FAKE_STDLIB_H
+
+#include "pico.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
+
+static inline bool set_sys_clock_khz(uint32_t freq_khz, bool required) {
+	(void)freq_khz;
+	(void)required;
+	return true;
+}
+
+static inline bool stdio_init_all(void) {
+	return true;
+}
+
+#endif //PICO_FAKE_STDLIB_H
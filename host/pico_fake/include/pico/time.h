@@ -0,0 +1,35 @@
+/**
+ * @file time.h
+ * 时间取自主机单调时钟；sleep不真正等待，只把假时钟往前拨
+ */
+
+#ifndef PICO_FAKE_TIME_H
+#define PICO_FAKE_TIME_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t *rt);
+
+struct repeating_timer {
+	int64_t delay_us;
+	repeating_timer_callback_t callback;
+	void *user_data;
+};
+
+uint32_t time_us_32(void);
+uint64_t time_us_64(void);
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data,
+							repeating_timer_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PICO_FAKE_TIME_H
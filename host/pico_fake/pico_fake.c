@@ -0,0 +1,436 @@
+/**
+ * @file pico_fake.c
+ *
+ */
+
+#include "pico_fake.h"
+#include <string.h>
+#include <stddef.h>
+#include <time.h>
+#include "pico/time.h"
+#include "hardware/gpio.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+struct spi_inst {
+	spi_hw_t hw;
+	uint data_bits;
+	uint32_t bit_acc;		//不满一个字节的位，帧宽不是8的倍数时使用
+	uint bit_cnt;
+};
+
+typedef struct {
+	bool claimed;
+	bool irq0_enabled;
+	dma_channel_config cfg;
+	volatile void *write_addr;
+	const volatile void *read_addr;
+	uint32_t trans_count;
+} fake_dma_channel_t;
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static struct spi_inst spi_insts[2] = {{.data_bits = 8}, {.data_bits = 8}};
+spi_inst_t *const spi0 = &spi_insts[0];
+spi_inst_t *const spi1 = &spi_insts[1];
+
+static fake_dma_channel_t dma_channels[NUM_DMA_CHANNELS];
+static dma_hw_t fake_dma_hw __attribute__((aligned(sizeof(dma_channel_hw_t))));
+dma_hw_t *const dma_hw = &fake_dma_hw;
+static irq_handler_t dma_irq0_handler;
+static bool dma_irq0_enabled;
+
+static bool gpio_levels[PICO_FAKE_GPIO_COUNT];
+static uint64_t sleep_offset_us;
+static pico_fake_spi_sink_t spi_sink;
+
+pico_fake_stats_t pico_fake_stats;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void pico_fake_reset_stats(void) {
+	memset(&pico_fake_stats, 0, sizeof(pico_fake_stats));
+}
+
+void pico_fake_set_spi_sink(pico_fake_spi_sink_t sink) {
+	spi_sink = sink;
+}
+
+/*-------------------------------- time --------------------------------*/
+
+uint64_t time_us_64(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000u + ts.tv_nsec / 1000u + sleep_offset_us;
+}
+
+uint32_t time_us_32(void) {
+	return (uint32_t)time_us_64();
+}
+
+void sleep_us(uint64_t us) {
+	sleep_offset_us += us;
+}
+
+void sleep_ms(uint32_t ms) {
+	sleep_us((uint64_t)ms * 1000u);
+}
+
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data,
+							repeating_timer_t *out) {
+	out->delay_us = (int64_t)delay_ms * 1000;
+	out->callback = callback;
+	out->user_data = user_data;
+	return true;
+}
+
+/*-------------------------------- gpio --------------------------------*/
+
+void gpio_init(uint gpio) {
+	(void)gpio;
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+	(void)gpio;
+	(void)out;
+}
+
+void gpio_put(uint gpio, bool value) {
+	if (gpio >= PICO_FAKE_GPIO_COUNT) return;
+	if (gpio_levels[gpio] != value) pico_fake_stats.gpio_edges[gpio]++;
+	gpio_levels[gpio] = value;
+}
+
+bool gpio_get(uint gpio) {
+	return gpio < PICO_FAKE_GPIO_COUNT ? gpio_levels[gpio] : false;
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn) {
+	(void)gpio;
+	(void)fn;
+}
+
+void gpio_pull_up(uint gpio) {
+	(void)gpio;
+}
+
+/*-------------------------------- spi ---------------------------------*/
+
+/**
+ * @brief 按帧宽把一帧的低data_bits位高位在前接到位流上，每凑满8位交给接收函数一个字节
+ */
+static void spi_push_frame(spi_inst_t *spi, uint16_t frame) {
+	pico_fake_stats.bus_bits += spi->data_bits;
+	spi->bit_acc = (spi->bit_acc << spi->data_bits) | (frame & ((1u << spi->data_bits) - 1));
+	spi->bit_cnt += spi->data_bits;
+	while (spi->bit_cnt >= 8) {
+		spi->bit_cnt -= 8;
+		if (spi_sink) spi_sink(spi, (uint8_t)(spi->bit_acc >> spi->bit_cnt));
+	}
+	spi->bit_acc &= (1u << spi->bit_cnt) - 1;
+}
+
+uint spi_init(spi_inst_t *spi, uint baudrate) {
+	spi->data_bits = 8;
+	return baudrate;
+}
+
+void spi_set_format(spi_inst_t *spi, uint data_bits, spi_cpol_t cpol, spi_cpha_t cpha, spi_order_t order) {
+	(void)cpol;
+	(void)cpha;
+	(void)order;
+	//切换帧宽时不满一个字节的位补0送出
+	if (spi->bit_cnt) {
+		if (spi_sink) spi_sink(spi, (uint8_t)(spi->bit_acc << (8 - spi->bit_cnt)));
+		spi->bit_acc = 0;
+		spi->bit_cnt = 0;
+	}
+	spi->data_bits = data_bits;
+}
+
+int spi_write_blocking(spi_inst_t *spi, const uint8_t *src, size_t len) {
+	pico_fake_stats.spi_calls++;
+	pico_fake_stats.spi_bytes += len;
+	for (size_t i = 0; i < len; i++) spi_push_frame(spi, src[i]);
+	return (int)len;
+}
+
+int spi_write16_blocking(spi_inst_t *spi, const uint16_t *src, size_t len) {
+	pico_fake_stats.spi_calls++;
+	pico_fake_stats.spi_bytes += len * 2;
+	for (size_t i = 0; i < len; i++) spi_push_frame(spi, src[i]);
+	return (int)len;
+}
+
+spi_hw_t *spi_get_hw(spi_inst_t *spi) {
+	return &spi->hw;
+}
+
+uint spi_get_dreq(spi_inst_t *spi, bool is_tx) {
+	return (spi == spi0 ? 16u : 18u) + (is_tx ? 0u : 1u);
+}
+
+bool spi_is_busy(const spi_inst_t *spi) {
+	(void)spi;
+	return false;
+}
+
+/*-------------------------------- irq ---------------------------------*/
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler) {
+	if (num == DMA_IRQ_0) dma_irq0_handler = handler;
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+	if (num == DMA_IRQ_0) dma_irq0_enabled = enabled;
+}
+
+/*-------------------------------- dma ---------------------------------*/
+
+static spi_inst_t *spi_from_dr(volatile void *addr) {
+	for (int i = 0; i < 2; i++) {
+		if (addr == (volatile void *)&spi_insts[i].hw.dr) return &spi_insts[i];
+	}
+	return NULL;
+}
+
+static void dma_run(uint channel);
+
+static void dma_raise_irq(uint channel) {
+	if (dma_channels[channel].irq0_enabled && dma_irq0_enabled && dma_irq0_handler) {
+		pico_fake_stats.dma_irqs++;
+		dma_irq0_handler();
+	}
+}
+
+/**
+ * @brief 写地址落在某个通道的寄存器上时返回true
+ */
+static bool dma_reg_target(volatile void *addr, uint *channel, size_t *offset) {
+	uintptr_t a = (uintptr_t)addr;
+	uintptr_t base = (uintptr_t)&fake_dma_hw.ch[0];
+	if (a < base || a >= base + sizeof(fake_dma_hw.ch)) return false;
+
+	*channel = (uint)((a - base) / sizeof(dma_channel_hw_t));
+	*offset = (a - base) % sizeof(dma_channel_hw_t);
+	return true;
+}
+
+/**
+ * @brief 模拟写一个DMA寄存器，只实现读/写地址、传输数和AL3触发；
+ * 读地址和传输数都为0的触发是空触发，IRQ_QUIET的通道此时产生中断
+ */
+static void dma_reg_write(uint channel, size_t offset, uintptr_t value) {
+	fake_dma_channel_t *ch = &dma_channels[channel];
+	*(io_rw_32 *)((uint8_t *)&fake_dma_hw.ch[channel] + offset) = value;
+
+	switch (offset) {
+	case offsetof(dma_channel_hw_t, read_addr):
+	case offsetof(dma_channel_hw_t, al1_read_addr):
+	case offsetof(dma_channel_hw_t, al2_read_addr):
+		ch->read_addr = (const volatile void *)value;
+		break;
+	case offsetof(dma_channel_hw_t, write_addr):
+	case offsetof(dma_channel_hw_t, al1_write_addr):
+	case offsetof(dma_channel_hw_t, al3_write_addr):
+		ch->write_addr = (volatile void *)value;
+		break;
+	case offsetof(dma_channel_hw_t, transfer_count):
+	case offsetof(dma_channel_hw_t, al2_transfer_count):
+	case offsetof(dma_channel_hw_t, al3_transfer_count):
+		ch->trans_count = (uint32_t)value;
+		break;
+	case offsetof(dma_channel_hw_t, al3_read_addr_trig):
+		ch->read_addr = (const volatile void *)value;
+		if (value == 0 && ch->trans_count == 0) {
+			if (ch->cfg.irq_quiet) dma_raise_irq(channel);
+		} else {
+			dma_run(channel);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief 立即执行整个传输：写地址是SPI的DR时把数据送上SPI，是DMA寄存器时模拟寄存器写，
+ * 否则按配置做内存拷贝。传输数和真实硬件一样作为重载值保留
+ */
+static void dma_run(uint channel) {
+	fake_dma_channel_t *ch = &dma_channels[channel];
+	spi_inst_t *spi = spi_from_dr(ch->write_addr);
+	uint reg_channel = 0;
+	size_t reg_offset = 0;
+	bool reg = dma_reg_target(ch->write_addr, &reg_channel, &reg_offset);
+	uint32_t size = reg ? (uint32_t)sizeof(io_rw_32) : 1u << ch->cfg.size;
+	uint32_t count = ch->trans_count;
+
+	pico_fake_stats.dma_starts++;
+	for (uint32_t i = 0; i < count; i++) {
+		const volatile uint8_t *rd = ch->read_addr;
+		volatile uint8_t *wr = ch->write_addr;
+		uint64_t v = 0;
+		for (uint32_t b = 0; b < size; b++) v |= (uint64_t)rd[b] << (8 * b);
+		if (ch->cfg.bswap && size == 2) v = ((v & 0xFF) << 8) | (v >> 8);
+		if (ch->cfg.bswap && size == 4) v = __builtin_bswap32((uint32_t)v);
+
+		//先更新地址再写：写寄存器可能触发别的通道，再经链式触发回到本通道
+		if (ch->cfg.read_increment) ch->read_addr = rd + size;
+		if (ch->cfg.write_increment) {
+			uintptr_t mask = ch->cfg.ring_sel && ch->cfg.ring_size_bits ? ((uintptr_t)1 << ch->cfg.ring_size_bits) - 1 : ~(uintptr_t)0;
+			ch->write_addr = (volatile void *)(((uintptr_t)wr & ~mask) | (((uintptr_t)wr + size) & mask));
+		}
+
+		if (spi) {
+			//SPI的帧宽不超过16位，高位被丢弃
+			spi_push_frame(spi, (uint16_t)v);
+			pico_fake_stats.dma_bytes += (spi->data_bits + 7) / 8;
+		} else if (reg) {
+			dma_reg_target(wr, &reg_channel, &reg_offset);
+			dma_reg_write(reg_channel, reg_offset, (uintptr_t)v);
+		} else {
+			for (uint32_t b = 0; b < size; b++) wr[b] = (uint8_t)(v >> (8 * b));
+		}
+	}
+
+	if (ch->cfg.chain_to != channel) dma_run(ch->cfg.chain_to);
+	if (!ch->cfg.irq_quiet) dma_raise_irq(channel);
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+	dma_channel_config c = {
+		.size = DMA_SIZE_32,
+		.read_increment = true,
+		.write_increment = false,
+		.bswap = false,
+		.irq_quiet = false,
+		.dreq = 0x3f,
+		.chain_to = channel,
+		.ring_sel = false,
+		.ring_size_bits = 0,
+	};
+	return c;
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {
+	c->size = size;
+}
+
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) {
+	c->read_increment = incr;
+}
+
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) {
+	c->write_increment = incr;
+}
+
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) {
+	c->dreq = dreq;
+}
+
+void channel_config_set_bswap(dma_channel_config *c, bool bswap) {
+	c->bswap = bswap;
+}
+
+void channel_config_set_chain_to(dma_channel_config *c, uint chain_to) {
+	c->chain_to = chain_to;
+}
+
+void channel_config_set_irq_quiet(dma_channel_config *c, bool irq_quiet) {
+	c->irq_quiet = irq_quiet;
+}
+
+void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits) {
+	c->ring_sel = write;
+	c->ring_size_bits = size_bits;
+}
+
+dma_channel_hw_t *dma_channel_hw_addr(uint channel) {
+	return &fake_dma_hw.ch[channel];
+}
+
+int dma_claim_unused_channel(bool required) {
+	for (uint i = 0; i < NUM_DMA_CHANNELS; i++) {
+		if (!dma_channels[i].claimed) {
+			dma_channels[i].claimed = true;
+			return (int)i;
+		}
+	}
+	return required ? 0 : -1;
+}
+
+void dma_channel_unclaim(uint channel) {
+	dma_channels[channel].claimed = false;
+}
+
+bool dma_channel_is_claimed(uint channel) {
+	return dma_channels[channel].claimed;
+}
+
+void dma_channel_cleanup(uint channel) {
+	dma_channels[channel].irq0_enabled = false;
+	dma_channels[channel].trans_count = 0;
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+						   const volatile void *read_addr, uint transfer_count, bool trigger) {
+	fake_dma_channel_t *ch = &dma_channels[channel];
+	ch->cfg = *config;
+	ch->write_addr = write_addr;
+	ch->read_addr = read_addr;
+	ch->trans_count = transfer_count;
+	if (trigger) dma_run(channel);
+}
+
+void dma_channel_set_config(uint channel, const dma_channel_config *config, bool trigger) {
+	dma_channels[channel].cfg = *config;
+	if (trigger) dma_run(channel);
+}
+
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger) {
+	dma_channels[channel].read_addr = read_addr;
+	if (trigger) dma_run(channel);
+}
+
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger) {
+	dma_channels[channel].write_addr = write_addr;
+	if (trigger) dma_run(channel);
+}
+
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger) {
+	dma_channels[channel].trans_count = trans_count;
+	if (trigger) dma_run(channel);
+}
+
+void dma_channel_start(uint channel) {
+	dma_run(channel);
+}
+
+bool dma_channel_is_busy(uint channel) {
+	(void)channel;
+	return false;
+}
+
+void dma_channel_wait_for_finish_blocking(uint channel) {
+	(void)channel;
+}
+
+/*传输都是立即完成的，没有可以中止的传输*/
+void dma_channel_abort(uint channel) {
+	(void)channel;
+}
+
+void dma_channel_set_irq0_enabled(uint channel, bool enabled) {
+	dma_channels[channel].irq0_enabled = enabled;
+}
+
+void dma_channel_acknowledge_irq0(uint channel) {
+	(void)channel;
+}
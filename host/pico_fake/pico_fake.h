@@ -0,0 +1,41 @@
+/**
+ * @file pico_fake.h
+ * pico_fake的统计和观察接口：记录SPI/DMA的传输次数和字节数，
+ * 并把送到SPI上的每个字节交给可选的接收函数
+ */
+
+#ifndef PICO_FAKE_H
+#define PICO_FAKE_H
+
+#include "pico.h"
+#include "hardware/spi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PICO_FAKE_GPIO_COUNT	(30)
+
+typedef struct {
+	uint32_t spi_calls;			//spi_write*_blocking调用次数
+	uint32_t spi_bytes;			//经spi_write*_blocking发送的字节数
+	uint32_t dma_starts;		//DMA传输启动次数
+	uint32_t dma_bytes;			//经DMA写入SPI的字节数（按帧宽向上取整到字节）
+	uint32_t bus_bits;			//SPI线上实际发出的位数
+	uint32_t dma_irqs;			//调用DMA完成中断的次数
+	uint32_t gpio_edges[PICO_FAKE_GPIO_COUNT];	//每个引脚的电平变化次数
+} pico_fake_stats_t;
+
+/*SPI上每发出一个字节调用一次：各帧按帧宽高位在前连成位流，每8位一个字节，例如两个12位帧是三个字节*/
+typedef void (*pico_fake_spi_sink_t)(spi_inst_t *spi, uint8_t byte);
+
+extern pico_fake_stats_t pico_fake_stats;
+
+void pico_fake_reset_stats(void);
+void pico_fake_set_spi_sink(pico_fake_spi_sink_t sink);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PICO_FAKE_H
@@ -0,0 +1,122 @@
+/**
+ * @file render_ui.c
+ * 不接屏幕运行完整的界面：lv_port_disp -> ST7789驱动 -> pico_fake的SPI -> st7789_emu，
+ * 跑完指定的时间后保存屏幕截图，并输出SPI上发送的数据量，用来在PC上检查界面和测量刷新开销
+ * 用法: render_ui [截图.ppm] [运行毫秒数]
+ * DISP_BUF_MODE_DIRECT编译时整屏缓冲就是LVGL眼中的屏幕，逐像素和模拟的显存内容比较
+ * 和main.cpp一样每500ms用一组假的测量值刷新一次读数标签
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "lvgl.h"
+#include "lv_port_disp.h"
+#include "pico_fake.h"
+#include "pico/time.h"
+#include "st7789.h"
+#include "st7789_emu.h"
+#include "ui.h"
+
+#define FRAME_MS		(LV_DISP_DEF_REFR_PERIOD)
+#define READING_MS		(500)
+
+#ifndef RENDER_UI_CHECK_FB
+#define RENDER_UI_CHECK_FB	0
+#endif
+
+#if RENDER_UI_CHECK_FB
+/**
+ * @brief 整屏缓冲和模拟屏幕上不一致的像素数
+ */
+static uint32_t check_fb(void) {
+	lv_disp_t *disp = lv_disp_get_default();
+	const lv_color_t *fb = disp->driver->draw_buf->buf1;
+	uint16_t w, h;
+	st7789_emu_screen_size(&w, &h);
+	if (w != lv_disp_get_hor_res(disp) || h != lv_disp_get_ver_res(disp)) {
+		printf("render_ui: screen is %ux%u, display is %dx%d\n", w, h, lv_disp_get_hor_res(disp),
+			   lv_disp_get_ver_res(disp));
+		return (uint32_t)w * h;
+	}
+
+	uint32_t mismatches = 0;
+	for (uint16_t y = 0; y < h; y++) {
+		for (uint16_t x = 0; x < w; x++) {
+			//LV_COLOR_16_SWAP: 缓冲里的字节顺序就是SPI上的顺序
+			uint16_t c = fb[y * w + x].full;
+			c = (uint16_t)(c << 8 | c >> 8);
+			if (st7789_emu_get_pixel(x, y) != c) mismatches++;
+		}
+	}
+	return mismatches;
+}
+#endif
+
+/**
+ * @brief 按main.cpp的格式写入第n组假的测量值
+ */
+static void update_readings(uint32_t n) {
+	lv_obj_t *ports[] = {ui_lb_port1, ui_lb_port2, ui_lb_port3, ui_lb_port4};
+	uint32_t total_mw = 0;
+	for (uint32_t i = 0; i < sizeof(ports) / sizeof(ports[0]); i++) {
+		uint32_t ma = (n * 37 + i * 290) % 1500;
+		uint32_t mw = ma * 5;
+		total_mw += mw;
+		lv_label_set_text_fmt(ports[i], "%04lumA %04lumW", (unsigned long)ma, (unsigned long)mw);
+	}
+	//LVGL的lv_snprintf不支持%f(LV_SPRINTF_USE_FLOAT为0)，按整数拼出main.cpp的"00.000 V"格式
+	uint32_t mv = 5000 + (n % 7) * 13;
+	lv_label_set_text_fmt(ui_lb_volt, "%02lu.%03lu V", (unsigned long)(mv / 1000), (unsigned long)(mv % 1000));
+	lv_label_set_text_fmt(ui_lb_tot_power, "%02lu.%03lu W", (unsigned long)(total_mw / 1000),
+						  (unsigned long)(total_mw % 1000));
+}
+
+int main(int argc, char **argv) {
+	const char *path = argc > 1 ? argv[1] : "render_ui.ppm";
+	uint32_t run_ms = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 0) : 3000;
+
+	st7789_emu_init();
+	lv_init();
+	lv_port_disp_init();
+	ui_init();
+	ST7789_SetBacklight(1);
+
+	uint32_t boot_bytes = st7789_emu_stats.bytes;
+	st7789_emu_reset_stats();
+	uint32_t frames = 0;
+	for (uint32_t t = 0; t < run_ms; t += FRAME_MS) {
+		if (t % READING_MS == 0) update_readings(t / READING_MS);
+		sleep_ms(FRAME_MS);
+		lv_tick_inc(FRAME_MS);
+		lv_timer_handler();
+		frames++;
+	}
+
+	printf("render_ui: init %lu B, then %lu ms (%lu timer runs): %lu B, %lu commands, %lu windows, %lu pixels\n",
+		   (unsigned long)boot_bytes, (unsigned long)run_ms, (unsigned long)frames,
+		   (unsigned long)st7789_emu_stats.bytes, (unsigned long)st7789_emu_stats.cmds,
+		   (unsigned long)st7789_emu_stats.windows, (unsigned long)st7789_emu_stats.pixels);
+
+#if LV_LABEL_LAYOUT_CACHE
+	lv_label_layout_cache_stats_t layout;
+	lv_label_get_layout_cache_stats(&layout);
+	printf("render_ui: label layout cache: %lu text measurements avoided, %lu measured\n",
+		   (unsigned long)layout.hits, (unsigned long)layout.misses);
+#endif
+
+#if RENDER_UI_CHECK_FB
+	uint32_t mismatches = check_fb();
+	printf("render_ui: %lu pixels differ from the frame buffer\n", (unsigned long)mismatches);
+#endif
+
+	if (!st7789_emu_save_ppm(path)) {
+		printf("render_ui: cannot write %s\n", path);
+		return 1;
+	}
+	printf("render_ui: screenshot saved to %s\n", path);
+#if RENDER_UI_CHECK_FB
+	return mismatches ? 1 : 0;
+#else
+	return 0;
+#endif
+}
@@ -0,0 +1,318 @@
+/**
+ * @file st7789_emu.c
+ *
+ * 地址映射：CASET/RASET给出的是逻辑列/页地址，MADCTL.MV把逻辑列映射到显存的行（门线），
+ * MX/MY再分别把显存的列/行倒过来；这样四个方向下驱动的X_SHIFT/Y_SHIFT都正好落在面板的可见区域
+ * 垂直滚动按门线进行：滚动区域内第g条门线显示显存的第TFA + (g - TFA + SSA - TFA) % VSA行
+ */
+
+#include "st7789_emu.h"
+#include <stdio.h>
+#include <string.h>
+#include "pico_fake.h"
+#include "hardware/gpio.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define CMD_SWRESET		0x01
+#define CMD_CASET		0x2A
+#define CMD_RASET		0x2B
+#define CMD_RAMWR		0x2C
+#define CMD_RAMWRC		0x3C
+#define CMD_VSCRDEF		0x33
+#define CMD_MADCTL		0x36
+#define CMD_VSCSAD		0x37
+#define CMD_COLMOD		0x3A
+
+#define MADCTL_MY		0x80
+#define MADCTL_MX		0x40
+#define MADCTL_MV		0x20
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+	uint8_t cmd;
+	uint8_t params[8];
+	uint8_t param_cnt;
+
+	uint8_t madctl;
+	uint8_t colmod;
+	uint16_t col_start, col_end;
+	uint16_t page_start, page_end;
+	uint16_t col, page;				//RAMWR的写指针（逻辑地址）
+
+	uint32_t bit_acc;				//RAMWR数据按像素位宽拼接
+	uint8_t bit_cnt;
+
+	uint16_t tfa, vsa;				//VSCRDEF的上固定区和滚动区，下固定区是剩下的门线
+	uint16_t ssa;					//VSCSAD
+} emu_state_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void emu_reset(void);
+static void emu_command(uint8_t cmd);
+static void emu_param(uint8_t byte);
+static void emu_ram_byte(uint8_t byte);
+static void emu_write_pixel(uint16_t color);
+static void emu_map(uint16_t c, uint16_t p, uint16_t *gram_col, uint16_t *gram_row);
+static void emu_unmap(uint16_t gram_col, uint16_t gram_row, uint16_t *c, uint16_t *p);
+static uint16_t emu_shown_row(uint16_t gate);
+static uint8_t emu_pixel_bits(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint16_t gram[ST7789_EMU_GRAM_ROWS][ST7789_EMU_GRAM_COLS];
+static emu_state_t st;
+
+st7789_emu_stats_t st7789_emu_stats;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void st7789_emu_init(void) {
+	emu_reset();
+	memset(gram, 0, sizeof(gram));
+	st7789_emu_reset_stats();
+	pico_fake_set_spi_sink(st7789_emu_spi_byte);
+}
+
+void st7789_emu_reset_stats(void) {
+	memset(&st7789_emu_stats, 0, sizeof(st7789_emu_stats));
+}
+
+void st7789_emu_spi_byte(spi_inst_t *spi, uint8_t byte) {
+	(void)spi;
+	if (gpio_get(ST7789_EMU_CS_PIN)) return;
+
+	st7789_emu_stats.bytes++;
+	if (!gpio_get(ST7789_EMU_DC_PIN)) {
+		emu_command(byte);
+	} else if (st.cmd == CMD_RAMWR || st.cmd == CMD_RAMWRC) {
+		st7789_emu_stats.ramwr_bytes++;
+		emu_ram_byte(byte);
+	} else {
+		emu_param(byte);
+	}
+}
+
+void st7789_emu_screen_size(uint16_t *w, uint16_t *h) {
+	if (st.madctl & MADCTL_MV) {
+		*w = ST7789_EMU_PANEL_ROWS;
+		*h = ST7789_EMU_PANEL_COLS;
+	} else {
+		*w = ST7789_EMU_PANEL_COLS;
+		*h = ST7789_EMU_PANEL_ROWS;
+	}
+}
+
+/**
+ * @brief 屏幕坐标以可见区域里逻辑地址最小的像素为原点，和驱动加上X_SHIFT/Y_SHIFT之前的坐标一致
+ */
+uint16_t st7789_emu_get_pixel(uint16_t x, uint16_t y) {
+	uint16_t c0 = UINT16_MAX, p0 = UINT16_MAX;
+	//可见区域是矩形，逻辑地址的最小值一定在某个角上
+	for (uint8_t i = 0; i < 4; i++) {
+		uint16_t c, p;
+		emu_unmap(ST7789_EMU_PANEL_COL + (i & 1 ? ST7789_EMU_PANEL_COLS - 1 : 0),
+				  ST7789_EMU_PANEL_ROW + (i & 2 ? ST7789_EMU_PANEL_ROWS - 1 : 0), &c, &p);
+		if (c < c0) c0 = c;
+		if (p < p0) p0 = p;
+	}
+
+	uint16_t gram_col, gram_row;
+	emu_map(c0 + x, p0 + y, &gram_col, &gram_row);
+	if (gram_col >= ST7789_EMU_GRAM_COLS || gram_row >= ST7789_EMU_GRAM_ROWS) return 0;
+	return gram[emu_shown_row(gram_row)][gram_col];
+}
+
+bool st7789_emu_save_ppm(const char *path) {
+	FILE *f = fopen(path, "wb");
+	if (f == NULL) return false;
+
+	uint16_t w, h;
+	st7789_emu_screen_size(&w, &h);
+	fprintf(f, "P6\n%u %u\n255\n", w, h);
+	for (uint16_t y = 0; y < h; y++) {
+		for (uint16_t x = 0; x < w; x++) {
+			uint16_t c = st7789_emu_get_pixel(x, y);
+			uint8_t r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+			uint8_t rgb[3] = {(uint8_t)(r << 3 | r >> 2), (uint8_t)(g << 2 | g >> 4), (uint8_t)(b << 3 | b >> 2)};
+			fwrite(rgb, 1, sizeof(rgb), f);
+		}
+	}
+	return fclose(f) == 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * @brief 上电/软件复位后的寄存器值
+ */
+static void emu_reset(void) {
+	memset(&st, 0, sizeof(st));
+	st.colmod = 0x66;
+	st.col_end = ST7789_EMU_GRAM_COLS - 1;
+	st.page_end = ST7789_EMU_GRAM_ROWS - 1;
+	st.vsa = ST7789_EMU_GRAM_ROWS;
+}
+
+static void emu_command(uint8_t cmd) {
+	st7789_emu_stats.cmds++;
+	st.cmd = cmd;
+	st.param_cnt = 0;
+	st.bit_acc = 0;
+	st.bit_cnt = 0;
+
+	switch (cmd) {
+	case CMD_SWRESET:
+		emu_reset();
+		break;
+	case CMD_RAMWR:
+		st.col = st.col_start;
+		st.page = st.page_start;
+		break;
+	case CMD_CASET:
+		st7789_emu_stats.windows++;
+		break;
+	default:
+		break;
+	}
+}
+
+static void emu_param(uint8_t byte) {
+	if (st.param_cnt >= sizeof(st.params)) return;
+	st.params[st.param_cnt++] = byte;
+	const uint8_t *p = st.params;
+
+	switch (st.cmd) {
+	case CMD_CASET:
+		if (st.param_cnt == 4) {
+			st.col_start = p[0] << 8 | p[1];
+			st.col_end = p[2] << 8 | p[3];
+		}
+		break;
+	case CMD_RASET:
+		if (st.param_cnt == 4) {
+			st.page_start = p[0] << 8 | p[1];
+			st.page_end = p[2] << 8 | p[3];
+		}
+		break;
+	case CMD_MADCTL:
+		st.madctl = p[0];
+		break;
+	case CMD_COLMOD:
+		st.colmod = p[0];
+		break;
+	case CMD_VSCRDEF:
+		if (st.param_cnt == 6) {
+			st.tfa = p[0] << 8 | p[1];
+			st.vsa = p[2] << 8 | p[3];
+		}
+		break;
+	case CMD_VSCSAD:
+		if (st.param_cnt == 2) {
+			st.ssa = p[0] << 8 | p[1];
+			st7789_emu_stats.scrolls++;
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief COLMOD低3位决定接口上每个像素的位数：12位两个像素占3字节，18位每个分量占一个字节的高6位
+ */
+static uint8_t emu_pixel_bits(void) {
+	switch (st.colmod & 0x07) {
+	case 0x03:
+		return 12;
+	case 0x05:
+		return 16;
+	default:
+		return 24;
+	}
+}
+
+static void emu_ram_byte(uint8_t byte) {
+	uint8_t bits = emu_pixel_bits();
+	st.bit_acc = (st.bit_acc << 8) | byte;
+	st.bit_cnt += 8;
+	if (st.bit_cnt < bits) return;
+
+	st.bit_cnt -= bits;
+	uint32_t px = (st.bit_acc >> st.bit_cnt) & ((1u << bits) - 1);
+	st.bit_acc &= (1u << st.bit_cnt) - 1;
+
+	//统一换成RGB565保存
+	uint16_t color;
+	if (bits == 12) {
+		uint16_t r = (px >> 8) & 0xF, g = (px >> 4) & 0xF, b = px & 0xF;
+		color = (uint16_t)((r << 1 | r >> 3) << 11 | (g << 2 | g >> 2) << 5 | (b << 1 | b >> 3));
+	} else if (bits == 16) {
+		color = (uint16_t)px;
+	} else {
+		color = (uint16_t)(((px >> 19) & 0x1F) << 11 | ((px >> 10) & 0x3F) << 5 | ((px >> 3) & 0x1F));
+	}
+	emu_write_pixel(color);
+}
+
+/**
+ * @brief 写一个像素，写指针在窗口内先沿列、再沿页前进，到窗口末尾回到起点
+ */
+static void emu_write_pixel(uint16_t color) {
+	uint16_t gram_col, gram_row;
+	emu_map(st.col, st.page, &gram_col, &gram_row);
+	if (gram_col < ST7789_EMU_GRAM_COLS && gram_row < ST7789_EMU_GRAM_ROWS) {
+		gram[gram_row][gram_col] = color;
+	}
+	st7789_emu_stats.pixels++;
+
+	if (st.col < st.col_end) {
+		st.col++;
+		return;
+	}
+	st.col = st.col_start;
+	st.page = st.page < st.page_end ? st.page + 1 : st.page_start;
+}
+
+static void emu_map(uint16_t c, uint16_t p, uint16_t *gram_col, uint16_t *gram_row) {
+	uint16_t col = c, row = p;
+	if (st.madctl & MADCTL_MV) {
+		col = p;
+		row = c;
+	}
+	if (st.madctl & MADCTL_MX) col = ST7789_EMU_GRAM_COLS - 1 - col;
+	if (st.madctl & MADCTL_MY) row = ST7789_EMU_GRAM_ROWS - 1 - row;
+	*gram_col = col;
+	*gram_row = row;
+}
+
+static void emu_unmap(uint16_t gram_col, uint16_t gram_row, uint16_t *c, uint16_t *p) {
+	if (st.madctl & MADCTL_MX) gram_col = ST7789_EMU_GRAM_COLS - 1 - gram_col;
+	if (st.madctl & MADCTL_MY) gram_row = ST7789_EMU_GRAM_ROWS - 1 - gram_row;
+	if (st.madctl & MADCTL_MV) {
+		*c = gram_row;
+		*p = gram_col;
+	} else {
+		*c = gram_col;
+		*p = gram_row;
+	}
+}
+
+/**
+ * @brief 第gate条门线上显示的显存行
+ */
+static uint16_t emu_shown_row(uint16_t gate) {
+	if (st.vsa == 0 || gate < st.tfa || gate >= st.tfa + st.vsa) return gate;
+	uint16_t offset = st.ssa >= st.tfa ? st.ssa - st.tfa : 0;
+	return st.tfa + (gate - st.tfa + offset) % st.vsa;
+}
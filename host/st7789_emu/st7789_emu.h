@@ -0,0 +1,68 @@
+/**
+ * @file st7789_emu.h
+ * 接在pico_fake的SPI上的ST7789模拟：按DC/CS解析命令，
+ * 按CASET/RASET/RAMWR、MADCTL、COLMOD和垂直滚动写入240x320的显存，
+ * 可以按屏幕当前的方向读出可见区域、保存PPM截图，并统计收到的命令和数据量
+ */
+
+#ifndef ST7789_EMU_H
+#define ST7789_EMU_H
+
+#include "pico.h"
+#include "hardware/spi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*控制器显存的大小（不旋转时的列数和行数），行就是门线*/
+#define ST7789_EMU_GRAM_COLS	(240)
+#define ST7789_EMU_GRAM_ROWS	(320)
+
+/*面板可见区域在显存中的位置，默认是1.14寸135x240的屏*/
+#ifndef ST7789_EMU_PANEL_COL
+#define ST7789_EMU_PANEL_COL	(52)
+#define ST7789_EMU_PANEL_ROW	(40)
+#define ST7789_EMU_PANEL_COLS	(135)
+#define ST7789_EMU_PANEL_ROWS	(240)
+#endif
+
+/*和板子上的接线一致*/
+#ifndef ST7789_EMU_DC_PIN
+#define ST7789_EMU_DC_PIN		(17)
+#define ST7789_EMU_CS_PIN		(20)
+#endif
+
+typedef struct {
+	uint32_t bytes;				//CS有效时收到的字节数
+	uint32_t cmds;				//命令数
+	uint32_t windows;			//CASET次数
+	uint32_t ramwr_bytes;		//RAMWR之后的数据字节数
+	uint32_t pixels;			//写入显存的像素数（包括可见区域之外的）
+	uint32_t scrolls;			//VSCSAD次数
+} st7789_emu_stats_t;
+
+extern st7789_emu_stats_t st7789_emu_stats;
+
+/* 复位控制器状态并清空显存，把自己设置为pico_fake的SPI接收函数 */
+void st7789_emu_init(void);
+
+/* SPI接收函数，自己另外设置接收函数时可以转发给这里 */
+void st7789_emu_spi_byte(spi_inst_t *spi, uint8_t byte);
+
+void st7789_emu_reset_stats(void);
+
+/* 按当前MADCTL的方向，屏幕可见区域的宽和高 */
+void st7789_emu_screen_size(uint16_t *w, uint16_t *h);
+
+/* 屏幕坐标(x, y)上实际显示的颜色(RGB565)，包括垂直滚动的效果 */
+uint16_t st7789_emu_get_pixel(uint16_t x, uint16_t y);
+
+/* 把当前显示的内容保存成二进制PPM(P6) */
+bool st7789_emu_save_ppm(const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ST7789_EMU_H
@@ -73,6 +73,13 @@
 /*Use the standard `memcpy` and `memset` instead of LVGL's own functions. (Might or might not be faster).*/
 #define LV_MEMCPY_MEMSET_STD 0
 
+/*Number of animation descriptors allocated once in `lv_init()` and reused by `lv_anim_start()`,
+ *so starting and finishing animations doesn't allocate from and fragment the heap. More animations are allocated as usual.
+ *0: allocate every animation*/
+#ifndef LV_ANIM_POOL_SIZE
+    #define LV_ANIM_POOL_SIZE 16
+#endif
+
 /*====================
    HAL SETTINGS
  *====================*/
@@ -172,6 +179,13 @@
  *Only used if software rotation is enabled in the display driver.*/
 #define LV_DISP_ROT_MAX_BUF (10*1024)
 
+/*Blend 8 bpp glyphs straight into the draw buffer with per-opacity tables of the text color
+ *when no draw masks are active, instead of building a mask line and calling the blender.
+ *Only used with 16 bit color depth. The tables of the last 2 text colors are kept (1.5 kB each)*/
+#ifndef LV_DRAW_SW_LETTER_FAST
+    #define LV_DRAW_SW_LETTER_FAST 1
+#endif
+
 /*-------------
  * GPU
  *-----------*/
@@ -401,6 +415,48 @@
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 1
 
+/*Keep the recently used glyphs of compressed fonts decompressed in an LRU cache of this size (in bytes, taken from LV_MEM_SIZE)
+ *instead of decompressing them again on every draw. 0: disable*/
+#ifndef LV_FONT_FMT_TXT_DECOMPR_CACHE_SIZE
+    #define LV_FONT_FMT_TXT_DECOMPR_CACHE_SIZE (8U * 1024U)
+#endif
+
+/*Copy the bitmaps of the glyphs actually used from fonts registered with `lv_font_fmt_txt_sram_cache_add()`
+ *into a static RAM pool of this size (in bytes) on first use. Glyphs that don't fit are read from the font as usual.
+ *Useful when the fonts are in XIP flash. 0: disable*/
+#ifndef LV_FONT_FMT_TXT_SRAM_CACHE_SIZE
+    #define LV_FONT_FMT_TXT_SRAM_CACHE_SIZE (4U * 1024U)
+#endif
+#if LV_FONT_FMT_TXT_SRAM_CACHE_SIZE
+    #define LV_FONT_FMT_TXT_SRAM_CACHE_GLYPHS 24    /*Max. number of cached glyphs*/
+    #define LV_FONT_FMT_TXT_SRAM_CACHE_FONTS 2      /*Max. number of registered fonts*/
+#endif
+
+/*Glyph ID lookup cache of the built-in fonts, stored in each font's `cache`.
+ *Remember the glyph ID of this many recently used letters in a direct-mapped table (power of 2).
+ *0: remember only the last letter*/
+#ifndef LV_FONT_FMT_TXT_GID_CACHE_SIZE
+    #define LV_FONT_FMT_TXT_GID_CACHE_SIZE 16
+#endif
+
+/*1: Fill a flat glyph ID table for U+0020..U+007F on first use, so ASCII text skips the cmap search*/
+#ifndef LV_FONT_FMT_TXT_GID_ASCII
+    #define LV_FONT_FMT_TXT_GID_ASCII 1
+#endif
+
+/*Kerning lookup acceleration of the built-in fonts, built on the first use of each font with kerning.
+ *A table of the kerning values of all U+0020..U+007F pairs (9 kB per font) is allocated from LV_MEM_SIZE
+ *as long as the tables of all fonts fit in this size (in bytes). 0: disable*/
+#ifndef LV_FONT_FMT_TXT_KERN_ASCII_MEM
+    #define LV_FONT_FMT_TXT_KERN_ASCII_MEM (10U * 1024U)
+#endif
+
+/*Remember the kerning value of this many recently used glyph pairs of fonts with pair based kerning
+ *in a direct-mapped table (power of 2), for pairs not covered by the ASCII table. 0: disable*/
+#ifndef LV_FONT_FMT_TXT_KERN_CACHE_SIZE
+    #define LV_FONT_FMT_TXT_KERN_CACHE_SIZE 16
+#endif
+
 /*Enable subpixel rendering*/
 #define LV_USE_FONT_SUBPX 0
 #if LV_USE_FONT_SUBPX
@@ -483,6 +539,14 @@
 #if LV_USE_LABEL
     #define LV_LABEL_TEXT_SELECTION 1 /*Enable selecting text of the label*/
     #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
+    /*Remember the measured size of the text for its "shape" (digits replaced by '0' if the font's digits have the same width),
+     *so updating a number doesn't measure the text again. Texts longer than LV_LABEL_LAYOUT_CACHE_LEN - 1 bytes are not cached*/
+    #ifndef LV_LABEL_LAYOUT_CACHE
+        #define LV_LABEL_LAYOUT_CACHE 1
+    #endif
+    #ifndef LV_LABEL_LAYOUT_CACHE_LEN
+        #define LV_LABEL_LAYOUT_CACHE_LEN 24
+    #endif
 #endif
 
 #define LV_USE_LINE       1
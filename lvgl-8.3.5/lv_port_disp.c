@@ -10,6 +10,7 @@
  *      INCLUDES
  *********************/
 #include "lv_port_disp.h"
+#include "lv_port_perf.h"
 #include <stdbool.h>
 #include <hardware/dma.h>
 #include "st7789.h"
@@ -27,7 +28,75 @@
 #define MY_DISP_VER_RES		135
 #define LV_VER_RES_MAX		MY_DISP_VER_RES
 
-#define ROWS				(60)
+#endif
+
+/*
+ * 绘制缓冲模式
+ * DISP_BUF_MODE_ONE:  一块DISP_BUF_ROWS行的缓冲，LVGL要等DMA把这一段送完才能画下一段
+ * DISP_BUF_MODE_TWO:  两块DISP_BUF_ROWS行的缓冲，DMA发送一块的同时LVGL画另一块
+ * DISP_BUF_MODE_FULL: 两块整屏缓冲 + full_refresh，每帧整屏发送；
+ *                     LVGL 8.3在整屏双缓冲下画下一帧前仍要等上一帧送完，所以没有重叠，
+ *                     两块整屏共约127KB，需要先把LV_MEM_SIZE调小
+ * DISP_BUF_MODE_DIRECT: 一块整屏缓冲 + direct_mode，LVGL只重画失效区域；
+ *                     一次刷新的所有区域攒到最后一次flush一起交给驱动，
+ *                     每块区域的行之间由DMA控制块衔接，整帧只调用一次lv_disp_flush_ready
+ */
+#define DISP_BUF_MODE_ONE		(1)
+#define DISP_BUF_MODE_TWO		(2)
+#define DISP_BUF_MODE_FULL		(3)
+#define DISP_BUF_MODE_DIRECT	(4)
+
+#ifndef DISP_BUF_MODE
+#define DISP_BUF_MODE		DISP_BUF_MODE_TWO
+#endif
+
+/*每块缓冲的行数，45行正好把135行的屏幕分成三段，两块共42KB*/
+#ifndef DISP_BUF_ROWS
+#define DISP_BUF_ROWS		(45)
+#endif
+
+#if DISP_BUF_MODE == DISP_BUF_MODE_FULL
+#undef DISP_BUF_ROWS
+#define DISP_BUF_ROWS		MY_DISP_VER_RES
+#if LV_MEM_SIZE > (64U * 1024U)
+#warning "DISP_BUF_MODE_FULL needs about 127KB of static RAM, reduce LV_MEM_SIZE"
+#endif
+#endif
+
+#if DISP_BUF_MODE == DISP_BUF_MODE_DIRECT
+#undef DISP_BUF_ROWS
+#define DISP_BUF_ROWS		MY_DISP_VER_RES
+#endif
+
+/*
+ * 仅DISP_BUF_MODE_DIRECT：发送前给失效区域涉及的每一整行算哈希，和上次发送时比较，
+ * 只发送内容真的变了的行，数值没变但重新渲染的标签不再占用SPI
+ */
+#ifndef DISP_ROW_DIFF
+#define DISP_ROW_DIFF		(DISP_BUF_MODE == DISP_BUF_MODE_DIRECT)
+#endif
+
+#if DISP_BUF_MODE != DISP_BUF_MODE_DIRECT
+#undef DISP_ROW_DIFF
+#define DISP_ROW_DIFF		0
+#endif
+
+/*
+ * 12位总线(ST7789_BUS_BPP == 12)在flush里把这一段原地转换成RGB444，
+ * 转换会破坏缓冲内容，只能用于每次都重新渲染整段的分段缓冲模式
+ */
+#if ST7789_BUS_BPP == 12 && (DISP_BUF_MODE == DISP_BUF_MODE_FULL || DISP_BUF_MODE == DISP_BUF_MODE_DIRECT)
+#error "ST7789_BUS_BPP 12 converts the draw buffer in place, use DISP_BUF_MODE_ONE or DISP_BUF_MODE_TWO"
+#endif
+
+/*
+ * 硬件滚动的滑动过渡(disp_slide_begin/disp_slide_set)：
+ * 只支持滚动方向是屏幕X轴的旋转方向，并且要通过DMA队列发送
+ */
+#if defined(ST7789_SCROLL_ALONG_X) && defined(USE_DMA)
+#define DISP_HW_SLIDE		1
+#else
+#define DISP_HW_SLIDE		0
 #endif
 
 /**********************
@@ -41,6 +110,18 @@ static void disp_init(void);
 
 static void disp_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p);
 
+#if DISP_BUF_MODE == DISP_BUF_MODE_DIRECT
+static uint16_t disp_direct_send(lv_disp_t *disp, lv_color_t *color_p, bool send);
+#endif
+
+#if DISP_BUF_MODE == DISP_BUF_MODE_DIRECT || DISP_HW_SLIDE
+static uint16_t disp_queue_area(const lv_area_t *a, const lv_color_t *px, lv_coord_t stride, bool send);
+#endif
+
+#if DISP_HW_SLIDE
+static void disp_slide_sync(void);
+#endif
+
 //static void gpu_fill(lv_disp_drv_t * disp_drv, lv_color_t * dest_buf, lv_coord_t dest_width,
 //        const lv_area_t * fill_area, lv_color_t color);
 
@@ -48,6 +129,34 @@ static void disp_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_
  *  STATIC VARIABLES
  **********************/
 static lv_disp_drv_t disp_drv; /*Descriptor of a display driver*/
+
+#ifdef USE_DMA
+static volatile uint16_t flush_pending;	//一次flush拆成多块发送时，还没发送完的块数
+#endif
+
+#if DISP_HW_SLIDE
+/*
+ * 滑动过渡：滚动区域[x1, x2]里，新内容的前revealed列已经写进显存，
+ * 滚动revealed列后显示在区域右端；显存里剩下的列还是旧内容，跟着滚到左边，不能写入
+ */
+static struct {
+	bool active;
+	lv_coord_t x1;
+	lv_coord_t x2;
+	lv_coord_t revealed;	//LVGL已经可以发送的列数
+	lv_coord_t shown;		//屏幕当前的滚动量
+} slide;
+#endif
+
+#if DISP_ROW_DIFF
+enum {
+	ROW_UNKNOWN = 0,
+	ROW_SAME,
+	ROW_CHANGED,
+};
+static uint32_t row_hash[MY_DISP_VER_RES];	//每行上次发送到屏幕时的哈希
+static uint8_t row_state[MY_DISP_VER_RES];	//本帧每行的比较结果
+#endif
 /**********************
  *      MACROS
  **********************/
@@ -87,23 +196,18 @@ void lv_port_disp_init(void) {
 	 *      and you only need to change the frame buffer's address.
 	 */
 
+#if DISP_BUF_MODE == DISP_BUF_MODE_ONE || DISP_BUF_MODE == DISP_BUF_MODE_DIRECT
 	/* Example for 1) */
-	static lv_disp_draw_buf_t draw_buf_dsc_1;
-	static lv_color_t buf_1[MY_DISP_HOR_RES * ROWS]; /*A buffer for 10 rows*/
-	lv_disp_draw_buf_init(&draw_buf_dsc_1, buf_1, NULL, MY_DISP_HOR_RES * ROWS); /*Initialize the display buffer*/
-
-	/* Example for 2) */
-	// static lv_disp_draw_buf_t draw_buf_dsc_2;
-	// static lv_color_t buf_2_1[MY_DISP_HOR_RES * 35]; /*A buffer for 10 rows*/
-	// static lv_color_t buf_2_2[MY_DISP_HOR_RES * 35]; /*An other buffer for 10 rows*/
-	// lv_disp_draw_buf_init(&draw_buf_dsc_2, buf_2_1, buf_2_2, MY_DISP_HOR_RES * 35); /*Initialize the display buffer*/
-
-	/* Example for 3) also set disp_drv.full_refresh = 1 below*/
-	// static lv_disp_draw_buf_t draw_buf_dsc_3;
-	// static lv_color_t buf_3_1[MY_DISP_HOR_RES * MY_DISP_VER_RES]; /*A screen sized buffer*/
-	// static lv_color_t buf_3_2[MY_DISP_HOR_RES * MY_DISP_VER_RES]; /*Another screen sized buffer*/
-	// lv_disp_draw_buf_init(&draw_buf_dsc_3, buf_3_1, buf_3_2,
-	//                       MY_DISP_HOR_RES * LV_VER_RES_MAX); /*Initialize the display buffer*/
+	static lv_disp_draw_buf_t draw_buf_dsc;
+	static lv_color_t buf_1[MY_DISP_HOR_RES * DISP_BUF_ROWS];
+	lv_disp_draw_buf_init(&draw_buf_dsc, buf_1, NULL, MY_DISP_HOR_RES * DISP_BUF_ROWS); /*Initialize the display buffer*/
+#else
+	/* Example for 2) and 3) */
+	static lv_disp_draw_buf_t draw_buf_dsc;
+	static lv_color_t buf_2_1[MY_DISP_HOR_RES * DISP_BUF_ROWS];
+	static lv_color_t buf_2_2[MY_DISP_HOR_RES * DISP_BUF_ROWS];
+	lv_disp_draw_buf_init(&draw_buf_dsc, buf_2_1, buf_2_2, MY_DISP_HOR_RES * DISP_BUF_ROWS); /*Initialize the display buffer*/
+#endif
 
 	/*-----------------------------------
 	 * Register the display in LVGL
@@ -121,10 +225,14 @@ void lv_port_disp_init(void) {
 	disp_drv.flush_cb = disp_flush;
 
 	/*Set a display buffer*/
-	disp_drv.draw_buf = &draw_buf_dsc_1;
+	disp_drv.draw_buf = &draw_buf_dsc;
 
 	/*Required for Example 3)*/
-	//disp_drv.full_refresh = 1;
+#if DISP_BUF_MODE == DISP_BUF_MODE_FULL
+	disp_drv.full_refresh = 1;
+#elif DISP_BUF_MODE == DISP_BUF_MODE_DIRECT
+	disp_drv.direct_mode = 1;
+#endif
 
 	/* Fill a memory array with a color if you have GPU.
 	 * Note that, in lv_conf.h you can enable GPUs that has built-in support in LVGL.
@@ -132,7 +240,10 @@ void lv_port_disp_init(void) {
 	//disp_drv.gpu_fill_cb = gpu_fill;
 
 	/*Finally register the driver*/
-	lv_disp_drv_register(&disp_drv);
+	lv_disp_t *disp = lv_disp_drv_register(&disp_drv);
+
+	/*LV_PORT_PERF: 渲染/DMA/空闲时间的直方图和每帧的计数，通过串口输出*/
+	lv_port_perf_init(disp);
 }
 
 /**********************
@@ -166,11 +277,63 @@ void disp_disable_update(void) {
  *You can use DMA or any hardware acceleration to do this operation in the background but
  *'lv_disp_flush_ready()' has to be called when finished.*/
 static void disp_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p) {
+	lv_port_perf_flush();
+
+#if DISP_BUF_MODE == DISP_BUF_MODE_DIRECT
+	/*
+	 * direct_mode下每块区域都直接画在整屏缓冲的对应位置，flush给出的总是整屏；
+	 * 前面的区域不发送，到本次刷新的最后一次flush再按LVGL记录的失效区域一起入队
+	 */
+	LV_UNUSED(area);
+	if (!disp_flush_enabled || !lv_disp_flush_is_last(disp_drv)) {
+		lv_disp_flush_ready(disp_drv);
+		return;
+	}
+
+	lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+#if DISP_ROW_DIFF
+	lv_memset_00(row_state, sizeof(row_state));
+#endif
+	uint16_t cnt = disp_direct_send(disp, color_p, false);
+	if (cnt == 0) {
+		lv_disp_flush_ready(disp_drv);
+	} else {
+		//先记下块数，驱动可能在入队过程中就完成了前几块
+		flush_pending = cnt;
+		disp_direct_send(disp, color_p, true);
+	}
+#if DISP_HW_SLIDE
+	disp_slide_sync();
+#endif
+#else
 	if (disp_flush_enabled) {
 		uint32_t w = (area->x2 - area->x1 + 1);
 		uint32_t h = (area->y2 - area->y1 + 1);
 
-		//dma_channel_wait_for_finish_blocking(DmaChann);
+#if ST7789_BUS_BPP == 12
+		ST7789_ConvertRGB444((uint16_t *) &color_p->full, w * h);
+#endif
+
+#if DISP_HW_SLIDE
+		if (slide.active) {
+			//lv_disp_flush_ready会清掉flushing_last，要在入队之前取
+			bool last = lv_disp_flush_is_last(disp_drv);
+			uint16_t cnt = disp_queue_area(area, color_p, w, false);
+			if (cnt == 0) {
+				lv_disp_flush_ready(disp_drv);
+			} else {
+				flush_pending = cnt;
+				disp_queue_area(area, color_p, w, true);
+			}
+			if (last) disp_slide_sync();
+			return;
+		}
+#endif
+
+		/*
+		 * ST7789_DrawImage只把这一段加入驱动的传输队列就返回，
+		 * 窗口命令、CS和DC由驱动在DMA中断里按顺序处理，整段发送完毕后调用dma_handler
+		 */
 		ST7789_DrawImage(area->x1, area->y1, w, h, (uint16_t *) &color_p->full);
 	}
 
@@ -179,12 +342,188 @@ static void disp_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_
 #ifndef USE_DMA
 	lv_disp_flush_ready(disp_drv);
 #endif
+#endif
+}
+
+#if DISP_ROW_DIFF
+/**
+ * @brief 第y行和上次发送时相比是否变化，每行每帧只算一次哈希(FNV-1a，按32位字)
+ */
+static bool disp_row_changed(const lv_color_t *fb, lv_coord_t y) {
+	if (row_state[y] == ROW_UNKNOWN) {
+		const uint32_t *p = (const uint32_t *) &fb[y * MY_DISP_HOR_RES];
+		uint32_t h = 2166136261u;
+		for (uint32_t i = 0; i < MY_DISP_HOR_RES * sizeof(lv_color_t) / sizeof(uint32_t); i++) {
+			h = (h ^ p[i]) * 16777619u;
+		}
+		row_state[y] = h == row_hash[y] ? ROW_SAME : ROW_CHANGED;
+		row_hash[y] = h;
+	}
+	return row_state[y] == ROW_CHANGED;
+}
+#endif
+
+#if DISP_BUF_MODE == DISP_BUF_MODE_DIRECT
+/**
+ * @brief 把本次刷新的失效区域切成需要发送的块，send为false时只计数
+ * 开启DISP_ROW_DIFF时每个区域只发送连续变化的行
+ * @return 块数
+ */
+static uint16_t disp_direct_send(lv_disp_t *disp, lv_color_t *color_p, bool send) {
+	uint16_t cnt = 0;
+#if DISP_ROW_DIFF
+	//滑动过渡期间还没露出的列不会发送，不能据此更新行哈希
+	bool diff = true;
+#if DISP_HW_SLIDE
+	diff = !slide.active;
+#endif
+#endif
+	for (uint16_t i = 0; i < disp->inv_p; i++) {
+		if (disp->inv_area_joined[i]) continue;
+		const lv_area_t *a = &disp->inv_areas[i];
+
+		lv_coord_t y1 = a->y1;
+		while (y1 <= a->y2) {
+			lv_coord_t y2 = a->y2;
+#if DISP_ROW_DIFF
+			if (diff) {
+				if (!disp_row_changed(color_p, y1)) {
+					if (send) lv_port_perf_count(LV_PORT_PERF_CNT_ROWS_SKIPPED, 1);
+					y1++;
+					continue;
+				}
+				y2 = y1;
+				while (y2 < a->y2 && disp_row_changed(color_p, y2 + 1)) y2++;
+			}
+			if (send) lv_port_perf_count(LV_PORT_PERF_CNT_ROWS_SENT, y2 - y1 + 1);
+#endif
+			lv_area_t run = {a->x1, y1, a->x2, y2};
+			cnt += disp_queue_area(&run, &color_p[y1 * MY_DISP_HOR_RES + a->x1], MY_DISP_HOR_RES, send);
+			y1 = y2 + 1;
+		}
+	}
+	return cnt;
+}
+#endif
+
+#if DISP_BUF_MODE == DISP_BUF_MODE_DIRECT || DISP_HW_SLIDE
+/**
+ * @brief 把缓冲里的一块区域交给驱动，px指向区域左上角，行之间相隔stride个像素
+ * 滑动过渡期间跳过还没露出的列，区域可能被拆成左右两块
+ * @return 块数，send为false时只计数
+ */
+static uint16_t disp_queue_area(const lv_area_t *a, const lv_color_t *px, lv_coord_t stride, bool send) {
+	lv_coord_t hide_x1 = a->x2 + 1, hide_x2 = a->x2;
+#if DISP_HW_SLIDE
+	if (slide.active) {
+		hide_x1 = LV_MAX(a->x1, slide.x1 + slide.revealed);
+		hide_x2 = LV_MIN(a->x2, slide.x2);
+		if (hide_x1 > hide_x2) hide_x1 = a->x2 + 1;
+	}
+#endif
+
+	uint16_t cnt = 0;
+	lv_coord_t h = lv_area_get_height(a);
+	if (hide_x1 > a->x1) {
+		if (send) ST7789_QueueImageStrided(a->x1, a->y1, hide_x1 - a->x1, h, (const uint16_t *) &px->full, stride);
+		cnt++;
+	}
+	if (hide_x1 <= a->x2 && hide_x2 < a->x2) {
+		const lv_color_t *right = px + (hide_x2 + 1 - a->x1);
+		if (send) ST7789_QueueImageStrided(hide_x2 + 1, a->y1, a->x2 - hide_x2, h, (const uint16_t *) &right->full, stride);
+		cnt++;
+	}
+	return cnt;
+}
+#endif
+
+#if DISP_HW_SLIDE
+/**
+ * @brief 一次刷新的最后一块已经入队时调用：等这一帧送完再滚动，让新露出的列出现在区域右端；
+ * 全部露出时滚动量回到0，取消滚动区域，结束过渡
+ */
+static void disp_slide_sync(void) {
+	if (!slide.active || slide.shown == slide.revealed) return;
+
+	//ST7789_SetScrollOffset会先等传输队列清空
+	ST7789_SetScrollOffset(slide.revealed);
+	slide.shown = slide.revealed;
+	if (slide.revealed == slide.x2 - slide.x1 + 1) {
+		ST7789_ResetScroll();
+		slide.active = false;
+#if DISP_ROW_DIFF
+		//过渡期间没有维护行哈希
+		lv_memset_00(row_hash, sizeof(row_hash));
+#endif
+	}
+}
+#endif
+
+/**
+ * @brief 开始一次硬件滚动的滑动过渡：屏幕上[x1, x2]列的旧内容向左推出，新内容从右侧推入
+ * 调用前对象应当已经在最终位置；之后LVGL只会把已经露出的列发送到屏幕
+ * @return false: 当前配置不支持硬件滚动，或者已经有过渡在进行
+ */
+bool disp_slide_begin(lv_coord_t x1, lv_coord_t x2) {
+#if DISP_HW_SLIDE
+	x1 = LV_MAX(x1, 0);
+	x2 = LV_MIN(x2, MY_DISP_HOR_RES - 1);
+	if (slide.active || x1 >= x2) return false;
+
+	ST7789_SetScrollArea(x1, x2 - x1 + 1);
+	slide.x1 = x1;
+	slide.x2 = x2;
+	slide.revealed = 0;
+	slide.shown = 0;
+	slide.active = true;
+	return true;
+#else
+	LV_UNUSED(x1);
+	LV_UNUSED(x2);
+	return false;
+#endif
+}
+
+/**
+ * @brief 推进滑动过渡：新内容露出revealed列，只有新露出的一条需要渲染和发送
+ * revealed达到区域宽度后，这一帧送完时过渡结束
+ */
+void disp_slide_set(lv_coord_t revealed) {
+#if DISP_HW_SLIDE
+	if (!slide.active) return;
+	revealed = LV_CLAMP(slide.revealed, revealed, slide.x2 - slide.x1 + 1);
+	if (revealed == slide.revealed) return;
+
+	lv_area_t strip = {slide.x1 + slide.revealed, 0, slide.x1 + revealed - 1, MY_DISP_VER_RES - 1};
+	slide.revealed = revealed;
+	_lv_inv_area(lv_disp_get_default(), &strip);
+#else
+	LV_UNUSED(revealed);
+#endif
+}
+
+bool disp_slide_is_active(void) {
+#if DISP_HW_SLIDE
+	return slide.active;
+#else
+	return false;
+#endif
 }
 
 #ifdef USE_DMA
+void dma_start_handler() {
+	lv_port_perf_dma_start();
+}
+
 void dma_handler() {
-	dma_channel_acknowledge_irq0(DmaChann);
 	//printf("Finished\n");
+	lv_port_perf_dma_done();
+#if LV_PORT_PERF
+	ST7789_QueueStats stats;
+	ST7789_GetQueueStats(&stats);
+	lv_port_perf_count(LV_PORT_PERF_CNT_DRV_US, stats.cpu_us_last);
+#endif
+	if (flush_pending && --flush_pending) return;
 	lv_disp_flush_ready(&disp_drv);
 }
 #endif
@@ -44,6 +44,13 @@ void disp_enable_update(void);
  */
 void disp_disable_update(void);
 
+/* Slide transition using the display's hardware scrolling, see lv_port_disp.c */
+bool disp_slide_begin(lv_coord_t x1, lv_coord_t x2);
+
+void disp_slide_set(lv_coord_t revealed);
+
+bool disp_slide_is_active(void);
+
 /**********************
  *      MACROS
  **********************/
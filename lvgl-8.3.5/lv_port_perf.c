@@ -0,0 +1,302 @@
+/**
+ * @file lv_port_perf.c
+ * 显示流水线计时，不在屏幕上画任何东西
+ *
+ * 打点位置：
+ *  - 刷新定时器：用包装函数替换_lv_disp_refr_timer，记录每次刷新的开始和结束
+ *  - wait_cb：LVGL开始等待DMA归还缓冲
+ *  - monitor_cb：本次刷新渲染的像素数
+ *  - disp_flush入口(lv_port_perf_flush)：等待结束，本次刷新算作一帧
+ *  - 驱动开始像素DMA(DMA_START_CB) / DMA完成中断(DMA_FINISH_CB)
+ *  - lv_port_perf_count：显示接口自己的计数（驱动CPU时间、行比较的结果）
+ * 一帧在下一次刷新开始时结算（最后一段DMA通常在刷新结束后才完成），
+ * 结果累加进直方图，攒够一个窗口后通过printf输出并清零
+ * lv_refr_now直接调用_lv_disp_refr_timer，不经过包装函数，不会被统计
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_port_perf.h"
+
+#if LV_PORT_PERF
+
+#include <stdio.h>
+#include <pico/time.h>
+#include <hardware/sync.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define PERF_BIN0_US		(64)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+	uint32_t refr_start;
+	uint32_t refr_end;
+	uint32_t stall_us;
+	uint32_t flushes;
+	bool dma_seen;
+	uint32_t dma_first;			//本帧第一次DMA开始
+	uint32_t dma_last;			//本帧最后一次DMA完成
+	uint32_t dma_in_refr_us;	//刷新期间DMA在发送的时间，包括等待缓冲的时间
+	uint32_t counts[_LV_PORT_PERF_CNT_NUM];
+} perf_frame_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void perf_refr_timer(lv_timer_t *timer);
+static void perf_wait(lv_disp_drv_t *disp_drv);
+static void perf_monitor(lv_disp_drv_t *disp_drv, uint32_t time, uint32_t px);
+static void perf_frame_begin(void);
+static void perf_frame_end(void);
+static void perf_frame_finish(uint32_t now);
+static void perf_wait_end(uint32_t now);
+static void perf_add(lv_port_perf_metric_t metric, uint32_t us);
+static uint8_t perf_bin(uint32_t us);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const char *const metric_names[_LV_PORT_PERF_METRIC_NUM] = {
+	"render", "stall", "flush", "overlap", "idle",
+};
+
+static const char *const counter_names[_LV_PORT_PERF_CNT_NUM] = {
+	"px", "flushes", "xfers", "drv_us", "rows", "skipped",
+};
+
+static void (*prev_wait_cb)(lv_disp_drv_t *disp_drv);
+static void (*prev_monitor_cb)(lv_disp_drv_t *disp_drv, uint32_t time, uint32_t px);
+
+static perf_frame_t frame;				//DMA中断也会修改，线程里读写时要关中断
+static volatile bool in_refr;
+static volatile bool dma_active;
+static volatile uint32_t dma_start_us;
+
+static bool waiting;
+static uint32_t wait_start_us;
+
+static bool have_prev;
+static uint32_t prev_end_us;			//上一帧渲染和DMA都结束的时间
+
+static lv_port_perf_hist_t hist;
+static uint32_t window_start_us;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * @brief 接管disp的刷新定时器、wait_cb和monitor_cb，原来的回调仍然会被调用
+ * @param disp 显示器，NULL表示默认显示器
+ */
+void lv_port_perf_init(lv_disp_t *disp) {
+	if (disp == NULL) disp = lv_disp_get_default();
+	if (disp == NULL) return;
+
+	lv_timer_set_cb(_lv_disp_get_refr_timer(disp), perf_refr_timer);
+	prev_wait_cb = disp->driver->wait_cb;
+	disp->driver->wait_cb = perf_wait;
+	prev_monitor_cb = disp->driver->monitor_cb;
+	disp->driver->monitor_cb = perf_monitor;
+	window_start_us = time_us_32();
+}
+
+/**
+ * @brief disp_flush入口：LVGL拿到空闲缓冲，等待结束
+ */
+void lv_port_perf_flush(void) {
+	perf_wait_end(time_us_32());
+	frame.flushes++;
+	lv_port_perf_count(LV_PORT_PERF_CNT_FLUSHES, 1);
+}
+
+/**
+ * @brief 像素DMA开始，驱动在关中断时或者DMA中断里调用
+ */
+void lv_port_perf_dma_start(void) {
+	uint32_t now = time_us_32();
+	dma_active = true;
+	dma_start_us = now;
+	if (!frame.dma_seen) {
+		frame.dma_seen = true;
+		frame.dma_first = now;
+	}
+}
+
+/**
+ * @brief 一块图像发送完毕，在DMA中断里调用
+ */
+void lv_port_perf_dma_done(void) {
+	uint32_t now = time_us_32();
+	if (!dma_active) return;
+	dma_active = false;
+
+	//上一帧留下的DMA在本帧开始时已经结算过了
+	if (!frame.dma_seen || (int32_t)(dma_start_us - frame.refr_start) < 0) return;
+	frame.dma_last = now;
+	if (in_refr) frame.dma_in_refr_us += now - dma_start_us;
+	frame.counts[LV_PORT_PERF_CNT_XFERS]++;
+}
+
+void lv_port_perf_count(lv_port_perf_counter_t counter, uint32_t n) {
+	uint32_t irq_state = save_and_disable_interrupts();
+	frame.counts[counter] += n;
+	restore_interrupts(irq_state);
+}
+
+void lv_port_perf_get(lv_port_perf_hist_t *h) {
+	*h = hist;
+}
+
+/**
+ * @brief 输出当前窗口的直方图并清零，每个指标一行：平均值、最大值和各桶的帧数(us)；
+ * 最后一行是各个计数的每帧平均值
+ */
+void lv_port_perf_report(void) {
+	uint32_t now = time_us_32();
+	printf("perf: %lu frames in %lu ms\n", (unsigned long)hist.frames,
+		   (unsigned long)((now - window_start_us) / 1000));
+
+	if (hist.frames) {
+		printf("perf: %-8s %6s %6s |", "us", "avg", "max");
+		for (uint8_t i = 0; i < LV_PORT_PERF_BINS - 1; i++) {
+			uint32_t limit = (uint32_t)PERF_BIN0_US << i;
+			if (limit < 1000) printf(" <%4lu", (unsigned long)limit);
+			else printf(" <%3lum", (unsigned long)(limit / 1000));
+		}
+		printf("  more\n");
+
+		for (uint8_t m = 0; m < _LV_PORT_PERF_METRIC_NUM; m++) {
+			printf("perf: %-8s %6lu %6lu |", metric_names[m], (unsigned long)(hist.sum_us[m] / hist.frames),
+				   (unsigned long)hist.max_us[m]);
+			for (uint8_t i = 0; i < LV_PORT_PERF_BINS; i++) {
+				printf(" %5lu", (unsigned long)hist.bins[m][i]);
+			}
+			printf("\n");
+		}
+
+		printf("perf: per frame");
+		for (uint8_t c = 0; c < _LV_PORT_PERF_CNT_NUM; c++) {
+			printf(" %s %lu", counter_names[c], (unsigned long)(hist.counts[c] / hist.frames));
+		}
+		printf("\n");
+	}
+
+	lv_memset_00(&hist, sizeof(hist));
+	window_start_us = time_us_32();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void perf_refr_timer(lv_timer_t *timer) {
+	perf_frame_begin();
+	_lv_disp_refr_timer(timer);
+	perf_frame_end();
+}
+
+static void perf_wait(lv_disp_drv_t *disp_drv) {
+	if (!waiting) {
+		waiting = true;
+		wait_start_us = time_us_32();
+	}
+	if (prev_wait_cb) prev_wait_cb(disp_drv);
+}
+
+static void perf_monitor(lv_disp_drv_t *disp_drv, uint32_t time, uint32_t px) {
+	lv_port_perf_count(LV_PORT_PERF_CNT_PX, px);
+	if (prev_monitor_cb) prev_monitor_cb(disp_drv, time, px);
+}
+
+static void perf_wait_end(uint32_t now) {
+	if (!waiting) return;
+	waiting = false;
+	frame.stall_us += now - wait_start_us;
+}
+
+/**
+ * @brief 刷新开始：先结算上一帧，再开始记录新的一帧
+ */
+static void perf_frame_begin(void) {
+	uint32_t now = time_us_32();
+	uint32_t irq_state = save_and_disable_interrupts();
+	if (frame.flushes) perf_frame_finish(now);
+	lv_memset_00(&frame, sizeof(frame));
+	frame.refr_start = now;
+	in_refr = true;
+	restore_interrupts(irq_state);
+}
+
+/**
+ * @brief 刷新结束：还在发送的DMA到此为止的时间也算作和刷新重叠
+ */
+static void perf_frame_end(void) {
+	uint32_t now = time_us_32();
+	perf_wait_end(now);
+
+	uint32_t irq_state = save_and_disable_interrupts();
+	in_refr = false;
+	frame.refr_end = now;
+	if (dma_active && frame.dma_seen && (int32_t)(dma_start_us - frame.refr_start) >= 0) {
+		frame.dma_in_refr_us += now - dma_start_us;
+	}
+	restore_interrupts(irq_state);
+
+	if (hist.frames >= LV_PORT_PERF_WINDOW ||
+		(hist.frames && now - window_start_us >= LV_PORT_PERF_PERIOD * 1000u)) {
+		lv_port_perf_report();
+	}
+}
+
+/**
+ * @brief 结算一帧，调用时已关中断；DMA还没发送完时按now计
+ */
+static void perf_frame_finish(uint32_t now) {
+	if (frame.dma_seen && dma_active) frame.dma_last = now;
+
+	uint32_t refr_us = frame.refr_end - frame.refr_start;
+	uint32_t render_us = refr_us > frame.stall_us ? refr_us - frame.stall_us : 0;
+	uint32_t flush_us = frame.dma_seen ? frame.dma_last - frame.dma_first : 0;
+	//等待缓冲时DMA一定在发送，这段不算重叠
+	uint32_t overlap_us = frame.dma_in_refr_us > frame.stall_us ? frame.dma_in_refr_us - frame.stall_us : 0;
+
+	perf_add(LV_PORT_PERF_RENDER, render_us);
+	perf_add(LV_PORT_PERF_STALL, frame.stall_us);
+	perf_add(LV_PORT_PERF_FLUSH, flush_us);
+	perf_add(LV_PORT_PERF_OVERLAP, overlap_us);
+	if (have_prev) perf_add(LV_PORT_PERF_IDLE, frame.refr_start - prev_end_us);
+	for (uint8_t c = 0; c < _LV_PORT_PERF_CNT_NUM; c++) hist.counts[c] += frame.counts[c];
+	hist.frames++;
+
+	prev_end_us = frame.refr_end;
+	if (frame.dma_seen && (int32_t)(frame.dma_last - prev_end_us) > 0) prev_end_us = frame.dma_last;
+	have_prev = true;
+}
+
+static void perf_add(lv_port_perf_metric_t metric, uint32_t us) {
+	hist.bins[metric][perf_bin(us)]++;
+	hist.sum_us[metric] += us;
+	if (us > hist.max_us[metric]) hist.max_us[metric] = us;
+}
+
+static uint8_t perf_bin(uint32_t us) {
+	uint8_t bin = 0;
+	us /= PERF_BIN0_US;
+	while (us && bin < LV_PORT_PERF_BINS - 1) {
+		us >>= 1;
+		bin++;
+	}
+	return bin;
+}
+
+#else
+
+/*This dummy typedef exists purely to silence -Wpedantic.*/
+typedef int keep_pedantic_happy;
+#endif /*LV_PORT_PERF*/
@@ -0,0 +1,111 @@
+/**
+ * @file lv_port_perf.h
+ * 显示流水线计时：渲染、等待缓冲、DMA发送和空闲时间的滚动直方图，
+ * 以及每帧的像素数、flush次数、传输次数等计数，通过串口输出
+ */
+
+#ifndef LV_PORT_PERF_H
+#define LV_PORT_PERF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#if defined(LV_LVGL_H_INCLUDE_SIMPLE)
+#include "lvgl.h"
+#else
+#include "lvgl/lvgl.h"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+/*置1时开启计时，默认关闭，关闭时下面的打点接口都是空宏*/
+#ifndef LV_PORT_PERF
+#define LV_PORT_PERF			0
+#endif
+
+/*攒够这么多帧，或者距上次输出超过LV_PORT_PERF_PERIOD毫秒，就输出一次直方图并清零*/
+#ifndef LV_PORT_PERF_WINDOW
+#define LV_PORT_PERF_WINDOW		(120)
+#endif
+
+#ifndef LV_PORT_PERF_PERIOD
+#define LV_PORT_PERF_PERIOD		(5000)
+#endif
+
+/*直方图按2的幂分桶：第0桶 < 64us，第i桶 < 64us << i，最后一桶是剩下的所有值*/
+#define LV_PORT_PERF_BINS		(12)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+	LV_PORT_PERF_RENDER = 0,	//刷新定时器里除去等待缓冲以外的时间
+	LV_PORT_PERF_STALL,			//LVGL等待DMA归还缓冲的时间
+	LV_PORT_PERF_FLUSH,			//本帧第一次DMA开始到最后一次DMA完成
+	LV_PORT_PERF_OVERLAP,		//渲染的同时DMA也在发送的时间
+	LV_PORT_PERF_IDLE,			//上一帧完全结束(渲染和DMA)到本帧开始刷新
+	_LV_PORT_PERF_METRIC_NUM,
+} lv_port_perf_metric_t;
+
+typedef enum {
+	LV_PORT_PERF_CNT_PX = 0,		//LVGL渲染的像素数
+	LV_PORT_PERF_CNT_FLUSHES,		//disp_flush的调用次数
+	LV_PORT_PERF_CNT_XFERS,			//发送完的图像块数
+	LV_PORT_PERF_CNT_DRV_US,		//驱动花在这些图像块上的CPU时间（入队、窗口命令和完成中断）
+	LV_PORT_PERF_CNT_ROWS_SENT,		//DISP_ROW_DIFF：发送的行数
+	LV_PORT_PERF_CNT_ROWS_SKIPPED,	//DISP_ROW_DIFF：和上次发送的内容相同而跳过的行数
+	_LV_PORT_PERF_CNT_NUM,
+} lv_port_perf_counter_t;
+
+typedef struct {
+	uint32_t frames;
+	uint32_t bins[_LV_PORT_PERF_METRIC_NUM][LV_PORT_PERF_BINS];
+	uint32_t sum_us[_LV_PORT_PERF_METRIC_NUM];
+	uint32_t max_us[_LV_PORT_PERF_METRIC_NUM];
+	uint32_t counts[_LV_PORT_PERF_CNT_NUM];
+} lv_port_perf_hist_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+#if LV_PORT_PERF
+/* 在lv_disp_drv_register之后调用，接管刷新定时器、wait_cb和monitor_cb */
+void lv_port_perf_init(lv_disp_t *disp);
+
+/* 打点：disp_flush入口、像素DMA开始、DMA完成(可以在中断里调用) */
+void lv_port_perf_flush(void);
+
+void lv_port_perf_dma_start(void);
+
+void lv_port_perf_dma_done(void);
+
+/* 给本帧的计数加n(可以在中断里调用) */
+void lv_port_perf_count(lv_port_perf_counter_t counter, uint32_t n);
+
+/* 读取当前窗口的直方图 */
+void lv_port_perf_get(lv_port_perf_hist_t *hist);
+
+/* 立即输出当前窗口的直方图并清零 */
+void lv_port_perf_report(void);
+#else
+#define lv_port_perf_init(disp)		LV_UNUSED(disp)
+#define lv_port_perf_flush()
+#define lv_port_perf_dma_start()
+#define lv_port_perf_dma_done()
+#define lv_port_perf_count(counter, n)
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_PORT_PERF_H*/
@@ -18,6 +18,11 @@
 /*********************
  *      DEFINES
  *********************/
+/*`lv_color_mix_premult` gives the same result as `lv_color_mix` only if the latter uses the generic formula*/
+#define LETTER_FAST_8BPP    (LV_DRAW_SW_LETTER_FAST && LV_COLOR_DEPTH == 16 && \
+                             !(LV_COLOR_16_SWAP == 0 && LV_COLOR_MIX_ROUND_OFS == 0))
+
+#define LETTER_FAST_COLORS  2
 
 /**********************
  *      TYPEDEFS
@@ -30,6 +35,12 @@
 LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
                                                      const lv_point_t * pos, lv_font_glyph_dsc_t * g, const uint8_t * map_p);
 
+#if LETTER_FAST_8BPP
+LV_ATTRIBUTE_FAST_MEM static bool draw_letter_8bpp_fast(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                                                        const lv_area_t * fill_area, const uint8_t * map_p, int32_t map_stride);
+static uint16_t * letter_premult_table(lv_color_t color);
+#endif
+
 
 #if LV_DRAW_COMPLEX && LV_USE_FONT_SUBPX
 static void draw_letter_subpx(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos,
@@ -248,6 +259,17 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
     uint32_t bit_ofs = (row_start * width_bit) + (col_start * bpp);
     map_p += bit_ofs >> 3;
 
+#if LETTER_FAST_8BPP
+    if(bpp == 8) {
+        lv_area_t glyph_area;
+        glyph_area.x1 = col_start + pos->x;
+        glyph_area.y1 = row_start + pos->y;
+        glyph_area.x2 = col_end + pos->x - 1;
+        glyph_area.y2 = row_end + pos->y - 1;
+        if(draw_letter_8bpp_fast(draw_ctx, dsc, &glyph_area, map_p, box_w)) return;
+    }
+#endif
+
     uint8_t letter_px;
     uint32_t col_bit;
     col_bit = bit_ofs & 0x7; /*"& 0x7" equals to "% 8" just faster*/
@@ -351,6 +373,83 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
     lv_mem_buf_release(mask_buf);
 }
 
+#if LETTER_FAST_8BPP
+/**
+ * Blend the coverage of an 8 bpp glyph directly into the draw buffer.
+ * Gives the same result as the mask + `lv_draw_sw_blend` path.
+ * @param fill_area the visible part of the glyph, already clipped
+ * @param map_p the glyph's bitmap at the top left corner of `fill_area`
+ * @param map_stride width of the glyph's bitmap
+ * @return false: masks, opacity, blend mode or the display settings need the generic path
+ */
+LV_ATTRIBUTE_FAST_MEM static bool draw_letter_8bpp_fast(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                                                        const lv_area_t * fill_area, const uint8_t * map_p, int32_t map_stride)
+{
+    if(dsc->opa < LV_OPA_MAX || dsc->blend_mode != LV_BLEND_MODE_NORMAL) return false;
+    if(((lv_draw_sw_ctx_t *)draw_ctx)->blend != lv_draw_sw_blend_basic) return false;
+
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp->driver->set_px_cb || disp->driver->screen_transp || disp->driver->antialiasing == 0) return false;
+#if LV_DRAW_COMPLEX
+    if(lv_draw_mask_is_any(fill_area)) return false;
+#endif
+
+    if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
+
+    uint16_t * premult = letter_premult_table(dsc->color);
+    lv_color_t color = dsc->color;
+    lv_coord_t dest_stride = lv_area_get_width(draw_ctx->buf_area);
+    lv_color_t * dest_buf = draw_ctx->buf;
+    dest_buf += dest_stride * (fill_area->y1 - draw_ctx->buf_area->y1) + (fill_area->x1 - draw_ctx->buf_area->x1);
+
+    int32_t w = lv_area_get_width(fill_area);
+    int32_t h = lv_area_get_height(fill_area);
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            lv_opa_t px = map_p[x];
+            if(px == LV_OPA_TRANSP) continue;
+            if(px == LV_OPA_COVER) dest_buf[x] = color;
+            else dest_buf[x] = lv_color_mix_premult(&premult[px * 3], dest_buf[x], 255 - px);
+        }
+        dest_buf += dest_stride;
+        map_p += map_stride;
+    }
+
+    return true;
+}
+
+/**
+ * Get the color premultiplied with every opacity.
+ * The tables of the last `LETTER_FAST_COLORS` colors are kept, the oldest one is replaced.
+ * @param color the text color
+ * @return 256 * 3 values, see `lv_color_premult`
+ */
+static uint16_t * letter_premult_table(lv_color_t color)
+{
+    static uint16_t tables[LETTER_FAST_COLORS][256][3];
+    static lv_color_t table_colors[LETTER_FAST_COLORS];
+    static uint8_t table_cnt = 0;
+    static uint8_t table_next = 0;
+
+    uint32_t i;
+    for(i = 0; i < table_cnt; i++) {
+        if(table_colors[i].full == color.full) return tables[i][0];
+    }
+
+    uint8_t slot = table_next;
+    table_next = (table_next + 1) % LETTER_FAST_COLORS;
+    if(table_cnt < LETTER_FAST_COLORS) table_cnt++;
+
+    for(i = 0; i < 256; i++) {
+        lv_color_premult(color, (uint8_t)i, tables[slot][i]);
+    }
+    table_colors[slot] = color;
+    return tables[slot][0];
+}
+#endif /*LETTER_FAST_8BPP*/
+
 #if LV_DRAW_COMPLEX && LV_USE_FONT_SUBPX
 static void draw_letter_subpx(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos,
                               lv_font_glyph_dsc_t * g, const uint8_t * map_p)
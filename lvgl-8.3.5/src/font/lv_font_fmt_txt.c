@@ -18,6 +18,8 @@
 /*********************
  *      DEFINES
  *********************/
+/*Expected size of a decompressed glyph, sets the hash table size of the decompressed glyph cache*/
+#define DECOMPR_CACHE_AVG_GLYPH     256
 
 /**********************
  *      TYPEDEFS
@@ -28,15 +30,34 @@ typedef enum {
     RLE_STATE_COUNTER,
 } rle_state_t;
 
+typedef struct {
+    const lv_font_t * font;
+    uint32_t gid;
+} decompr_key_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static uint32_t cmap_lookup(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter);
+#if LV_FONT_FMT_TXT_GID_ASCII
+    static void gid_ascii_fill(const lv_font_fmt_txt_dsc_t * fdsc);
+#endif
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
+#if LV_FONT_FMT_TXT_KERN_ASCII_MEM || LV_FONT_FMT_TXT_KERN_CACHE_SIZE
+    static int8_t get_kern_accel(const lv_font_t * font, uint32_t gid_left, uint32_t letter_left, uint32_t letter_right);
+#endif
+#if LV_FONT_FMT_TXT_KERN_ASCII_MEM
+    static void kern_ascii_build(const lv_font_t * font);
+#endif
 static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
 static int32_t kern_pair_16_compare(const void * ref, const void * element);
 
+#if LV_FONT_FMT_TXT_SRAM_CACHE_SIZE
+    static const uint8_t * sram_cache_get(const lv_font_t * font, uint32_t gid);
+#endif
+
 #if LV_USE_FONT_COMPRESSED
     static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord_t h, uint8_t bpp, bool prefilter);
     static inline void decompress_line(uint8_t * out, lv_coord_t w);
@@ -44,6 +65,10 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
     static inline void bits_write(uint8_t * out, uint32_t bit_pos, uint8_t val, uint8_t len);
     static inline void rle_init(const uint8_t * in,  uint8_t bpp);
     static inline uint8_t rle_next(void);
+    #if LV_FONT_FMT_TXT_DECOMPR_CACHE_SIZE
+        static const uint8_t * decompr_cache_get(const lv_font_t * font, uint32_t gid, uint32_t buf_size);
+        static void decompr_cache_free(void * bitmap);
+    #endif
 #endif /*LV_USE_FONT_COMPRESSED*/
 
 /**********************
@@ -56,8 +81,35 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
     static uint8_t rle_prev_v;
     static uint8_t rle_cnt;
     static rle_state_t rle_state;
+    #if LV_FONT_FMT_TXT_DECOMPR_CACHE_SIZE
+        static lv_font_fmt_txt_decompr_cache_stats_t decompr_stats;
+    #endif
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_FONT_FMT_TXT_SRAM_CACHE_SIZE
+    typedef struct {
+        const lv_font_t * font;
+        uint32_t gid;
+        const uint8_t * bitmap;
+    } sram_glyph_t;
+
+    static const lv_font_t * sram_fonts[LV_FONT_FMT_TXT_SRAM_CACHE_FONTS];
+    static sram_glyph_t sram_glyphs[LV_FONT_FMT_TXT_SRAM_CACHE_GLYPHS];
+    static uint8_t sram_pool[LV_FONT_FMT_TXT_SRAM_CACHE_SIZE] LV_ATTRIBUTE_MEM_ALIGN;
+    static lv_font_fmt_txt_sram_cache_stats_t sram_stats;
+#endif
+
+#if LV_FONT_FMT_TXT_GID_CACHE_SIZE || LV_FONT_FMT_TXT_GID_ASCII
+    static lv_font_fmt_txt_gid_cache_stats_t gid_stats;
+#endif
+
+#if LV_FONT_FMT_TXT_KERN_ASCII_MEM || LV_FONT_FMT_TXT_KERN_CACHE_SIZE
+    static lv_font_fmt_txt_kern_stats_t kern_stats;
+#endif
+#if LV_FONT_FMT_TXT_KERN_ASCII_MEM
+    static uint32_t kern_ascii_used;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -87,7 +139,11 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
     const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
 
     if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
+#if LV_FONT_FMT_TXT_SRAM_CACHE_SIZE
+        return sram_cache_get(font, gid);
+#else
         return &fdsc->glyph_bitmap[gdsc->bitmap_index];
+#endif
     }
     /*Handle compressed bitmap*/
     else {
@@ -115,6 +171,12 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
                 break;
         }
 
+#if LV_FONT_FMT_TXT_DECOMPR_CACHE_SIZE
+        /*Fall back to the shared buffer if the glyph can't be cached*/
+        const uint8_t * cached = decompr_cache_get(font, gid, buf_size);
+        if(cached) return cached;
+#endif
+
         if(last_buf_size < buf_size) {
             uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
             LV_ASSERT_MALLOC(tmp);
@@ -159,10 +221,14 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
 
     int8_t kvalue = 0;
     if(fdsc->kern_dsc) {
+#if LV_FONT_FMT_TXT_KERN_ASCII_MEM || LV_FONT_FMT_TXT_KERN_CACHE_SIZE
+        kvalue = get_kern_accel(font, gid, unicode_letter, unicode_letter_next);
+#else
         uint32_t gid_next = get_glyph_dsc_id(font, unicode_letter_next);
         if(gid_next) {
             kvalue = get_kern_value(font, gid, gid_next);
         }
+#endif
     }
 
     /*Put together a glyph dsc*/
@@ -189,8 +255,87 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     return true;
 }
 
+#if LV_FONT_FMT_TXT_SRAM_CACHE_SIZE
+bool lv_font_fmt_txt_sram_cache_add(const lv_font_t * font)
+{
+    const lv_font_fmt_txt_dsc_t * fdsc = (const lv_font_fmt_txt_dsc_t *)font->dsc;
+    if(font->get_glyph_bitmap != lv_font_get_bitmap_fmt_txt) return false;
+    if(fdsc->bitmap_format != LV_FONT_FMT_TXT_PLAIN) return false;
+
+    uint32_t i;
+    for(i = 0; i < LV_FONT_FMT_TXT_SRAM_CACHE_FONTS; i++) {
+        if(sram_fonts[i] == font) return true;
+        if(sram_fonts[i] == NULL) {
+            sram_fonts[i] = font;
+            return true;
+        }
+    }
+
+    LV_LOG_WARN("No free slot, increase LV_FONT_FMT_TXT_SRAM_CACHE_FONTS");
+    return false;
+}
+
+void lv_font_fmt_txt_sram_cache_get_stats(lv_font_fmt_txt_sram_cache_stats_t * stats)
+{
+    *stats = sram_stats;
+}
+#endif
+
+#if LV_FONT_FMT_TXT_GID_CACHE_SIZE || LV_FONT_FMT_TXT_GID_ASCII
+void lv_font_fmt_txt_gid_cache_get_stats(lv_font_fmt_txt_gid_cache_stats_t * stats)
+{
+    *stats = gid_stats;
+}
+#endif
+
+#if LV_FONT_FMT_TXT_KERN_ASCII_MEM || LV_FONT_FMT_TXT_KERN_CACHE_SIZE
+void lv_font_fmt_txt_kern_accel_free(const lv_font_t * font)
+{
+    lv_font_fmt_txt_glyph_cache_t * cache = ((const lv_font_fmt_txt_dsc_t *)font->dsc)->cache;
+    if(cache == NULL) return;
+
+#if LV_FONT_FMT_TXT_KERN_ASCII_MEM
+    if(cache->kern_ascii) {
+        lv_mem_free(cache->kern_ascii);
+        cache->kern_ascii = NULL;
+        kern_ascii_used -= LV_FONT_FMT_TXT_GID_ASCII_CNT * LV_FONT_FMT_TXT_GID_ASCII_CNT;
+    }
+    cache->kern_ascii_state = 0;
+#endif
+#if LV_FONT_FMT_TXT_KERN_CACHE_SIZE
+    lv_memset_00(cache->kern, sizeof(cache->kern));
+#endif
+}
+
+void lv_font_fmt_txt_kern_get_stats(lv_font_fmt_txt_kern_stats_t * stats)
+{
+    *stats = kern_stats;
+#if LV_FONT_FMT_TXT_KERN_ASCII_MEM
+    stats->ascii_used = kern_ascii_used;
+#endif
+}
+#endif
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_DECOMPR_CACHE_SIZE
+void lv_font_fmt_txt_decompr_cache_clear(void)
+{
+    if(LV_GC_ROOT(_lv_font_decompr_cache)) {
+        lv_lru_del(LV_GC_ROOT(_lv_font_decompr_cache));
+        LV_GC_ROOT(_lv_font_decompr_cache) = NULL;
+    }
+}
+
+void lv_font_fmt_txt_decompr_cache_get_stats(lv_font_fmt_txt_decompr_cache_stats_t * stats)
+{
+    *stats = decompr_stats;
+    lv_lru_t * cache = LV_GC_ROOT(_lv_font_decompr_cache);
+    stats->used = cache ? (uint32_t)(cache->total_memory - cache->free_memory) : 0;
+}
+#endif
+
 /**
  * Free the allocated memories.
+ * The decompressed glyph cache is kept.
  */
 void _lv_font_clean_up_fmt_txt(void)
 {
@@ -211,16 +356,65 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
     if(letter == '\0') return 0;
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    lv_font_fmt_txt_glyph_cache_t * cache = fdsc->cache;
 
     /*Check the cache first*/
-    if(fdsc->cache && letter == fdsc->cache->last_letter) return fdsc->cache->last_glyph_id;
+#if LV_FONT_FMT_TXT_GID_ASCII
+    if(cache && letter >= LV_FONT_FMT_TXT_GID_ASCII_FIRST && letter <= LV_FONT_FMT_TXT_GID_ASCII_LAST) {
+        if(cache->ascii_state == 0) gid_ascii_fill(fdsc);
+        if(cache->ascii_state == 1) {
+            gid_stats.ascii_hits++;
+            return cache->ascii[letter - LV_FONT_FMT_TXT_GID_ASCII_FIRST];
+        }
+    }
+#endif
 
+#if LV_FONT_FMT_TXT_GID_CACHE_SIZE
+    lv_font_fmt_txt_gid_cache_entry_t * entry = NULL;
+    if(cache) {
+        /*Fold the higher bits in too, symbols like U+F0E7 and U+F287 would collide otherwise*/
+        entry = &cache->entries[(letter ^ (letter >> 4)) & (LV_FONT_FMT_TXT_GID_CACHE_SIZE - 1)];
+        if(entry->letter == letter) {
+            gid_stats.hits++;
+            return entry->glyph_id;
+        }
+    }
+#else
+    if(cache && letter == cache->last_letter) return cache->last_glyph_id;
+#endif
+
+    uint32_t glyph_id = cmap_lookup(fdsc, letter);
+#if LV_FONT_FMT_TXT_GID_CACHE_SIZE || LV_FONT_FMT_TXT_GID_ASCII
+    gid_stats.misses++;
+#endif
+
+    /*Update the cache*/
+#if LV_FONT_FMT_TXT_GID_CACHE_SIZE
+    if(entry) {
+        entry->letter = letter;
+        entry->glyph_id = glyph_id;
+    }
+#else
+    if(cache) {
+        cache->last_letter = letter;
+        cache->last_glyph_id = glyph_id;
+    }
+#endif
+    return glyph_id;
+}
+
+/**
+ * Search the cmaps of a font.
+ * @return the glyph ID of the letter or 0 if not found
+ */
+static uint32_t cmap_lookup(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
+{
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
 
         /*Relative code point*/
         uint32_t rcp = letter - fdsc->cmaps[i].range_start;
-        if(rcp > fdsc->cmaps[i].range_length) continue;
+        if(rcp >= fdsc->cmaps[i].range_length) continue;
         uint32_t glyph_id = 0;
         if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
             glyph_id = fdsc->cmaps[i].glyph_id_start + rcp;
@@ -251,21 +445,41 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
             }
         }
 
-        /*Update the cache*/
-        if(fdsc->cache) {
-            fdsc->cache->last_letter = letter;
-            fdsc->cache->last_glyph_id = glyph_id;
-        }
         return glyph_id;
     }
 
-    if(fdsc->cache) {
-        fdsc->cache->last_letter = letter;
-        fdsc->cache->last_glyph_id = 0;
-    }
     return 0;
+}
+
+#if LV_FONT_FMT_TXT_GID_ASCII
+/**
+ * Fill the ASCII table of the font's cache.
+ * Only the letters inside a cmap's range are looked up, the others stay 0 (not found).
+ * Fonts without any cmap in the ASCII range or with too large glyph IDs don't use the table.
+ */
+static void gid_ascii_fill(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    lv_font_fmt_txt_glyph_cache_t * cache = fdsc->cache;
+    cache->ascii_state = 2;
+    lv_memset_00(cache->ascii, sizeof(cache->ascii));
 
+    bool covered = false;
+    uint16_t i;
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        uint32_t first = LV_MAX(fdsc->cmaps[i].range_start, LV_FONT_FMT_TXT_GID_ASCII_FIRST);
+        uint32_t last = LV_MIN(fdsc->cmaps[i].range_start + fdsc->cmaps[i].range_length,
+                               LV_FONT_FMT_TXT_GID_ASCII_LAST + 1);
+        uint32_t letter;
+        for(letter = first; letter < last; letter++) {
+            uint32_t glyph_id = cmap_lookup(fdsc, letter);
+            if(glyph_id > UINT16_MAX) return;
+            cache->ascii[letter - LV_FONT_FMT_TXT_GID_ASCII_FIRST] = (uint16_t)glyph_id;
+            covered = true;
+        }
+    }
+    if(covered) cache->ascii_state = 1;
 }
+#endif
 
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
 {
@@ -323,6 +537,94 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
     return value;
 }
 
+#if LV_FONT_FMT_TXT_KERN_ASCII_MEM || LV_FONT_FMT_TXT_KERN_CACHE_SIZE
+/**
+ * Get the kerning value of a letter pair from the ASCII table or the pair cache if possible.
+ * @param font pointer to a font with kerning
+ * @param gid_left glyph id of the left letter
+ * @param letter_left the left letter
+ * @param letter_right the right letter
+ * @return the unscaled kerning value
+ */
+static int8_t get_kern_accel(const lv_font_t * font, uint32_t gid_left, uint32_t letter_left, uint32_t letter_right)
+{
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    lv_font_fmt_txt_glyph_cache_t * cache = fdsc->cache;
+
+#if LV_FONT_FMT_TXT_KERN_ASCII_MEM
+    if(cache && letter_left >= LV_FONT_FMT_TXT_GID_ASCII_FIRST && letter_left <= LV_FONT_FMT_TXT_GID_ASCII_LAST &&
+       letter_right >= LV_FONT_FMT_TXT_GID_ASCII_FIRST && letter_right <= LV_FONT_FMT_TXT_GID_ASCII_LAST) {
+        if(cache->kern_ascii_state == 0) kern_ascii_build(font);
+        if(cache->kern_ascii_state == 1) {
+            kern_stats.ascii_hits++;
+            return cache->kern_ascii[(letter_left - LV_FONT_FMT_TXT_GID_ASCII_FIRST) * LV_FONT_FMT_TXT_GID_ASCII_CNT +
+                                     letter_right - LV_FONT_FMT_TXT_GID_ASCII_FIRST];
+        }
+    }
+#endif
+
+    uint32_t gid_right = get_glyph_dsc_id(font, letter_right);
+    if(gid_right == 0) return 0;
+
+#if LV_FONT_FMT_TXT_KERN_CACHE_SIZE
+    /*Class based kerning is only two table reads, cache the binary search of the pairs*/
+    if(cache && fdsc->kern_classes == 0 && gid_left <= UINT16_MAX && gid_right <= UINT16_MAX) {
+        lv_font_fmt_txt_kern_cache_entry_t * entry =
+            &cache->kern[(gid_left * 31 + gid_right) & (LV_FONT_FMT_TXT_KERN_CACHE_SIZE - 1)];
+        if(entry->gid_left == gid_left && entry->gid_right == gid_right) {
+            kern_stats.hits++;
+            return entry->value;
+        }
+
+        kern_stats.misses++;
+        entry->gid_left = (uint16_t)gid_left;
+        entry->gid_right = (uint16_t)gid_right;
+        entry->value = get_kern_value(font, gid_left, gid_right);
+        return entry->value;
+    }
+#endif
+
+    kern_stats.misses++;
+    return get_kern_value(font, gid_left, gid_right);
+}
+#endif
+
+#if LV_FONT_FMT_TXT_KERN_ASCII_MEM
+/**
+ * Allocate and fill the table of the kerning values of the ASCII pairs if it fits in LV_FONT_FMT_TXT_KERN_ASCII_MEM.
+ * @param font pointer to a font with kerning and `cache`
+ */
+static void kern_ascii_build(const lv_font_t * font)
+{
+    lv_font_fmt_txt_glyph_cache_t * cache = ((const lv_font_fmt_txt_dsc_t *)font->dsc)->cache;
+    cache->kern_ascii_state = 2;
+
+    uint32_t size = LV_FONT_FMT_TXT_GID_ASCII_CNT * LV_FONT_FMT_TXT_GID_ASCII_CNT;
+    if(kern_ascii_used + size > LV_FONT_FMT_TXT_KERN_ASCII_MEM) return;
+
+    int8_t * table = lv_mem_alloc(size);
+    if(table == NULL) return;
+    kern_ascii_used += size;
+
+    uint16_t gids[LV_FONT_FMT_TXT_GID_ASCII_CNT];
+    uint32_t i;
+    for(i = 0; i < LV_FONT_FMT_TXT_GID_ASCII_CNT; i++) {
+        gids[i] = (uint16_t)get_glyph_dsc_id(font, LV_FONT_FMT_TXT_GID_ASCII_FIRST + i);
+    }
+
+    for(i = 0; i < LV_FONT_FMT_TXT_GID_ASCII_CNT; i++) {
+        int8_t * row = &table[i * LV_FONT_FMT_TXT_GID_ASCII_CNT];
+        uint32_t k;
+        for(k = 0; k < LV_FONT_FMT_TXT_GID_ASCII_CNT; k++) {
+            row[k] = gids[i] && gids[k] ? get_kern_value(font, gids[i], gids[k]) : 0;
+        }
+    }
+
+    cache->kern_ascii = table;
+    cache->kern_ascii_state = 1;
+}
+#endif
+
 static int32_t kern_pair_8_compare(const void * ref, const void * element)
 {
     const uint8_t * ref8_p = ref;
@@ -344,7 +646,116 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element)
     else return (int32_t) ref16_p[1] - element16_p[1];
 }
 
+#if LV_FONT_FMT_TXT_SRAM_CACHE_SIZE
+/**
+ * Get the bitmap of an uncompressed glyph. Glyphs of registered fonts are copied to the RAM pool
+ * on first use while it has room, and served from there later.
+ * @param font pointer to font
+ * @param gid glyph id
+ * @return pointer to the bitmap
+ */
+static const uint8_t * sram_cache_get(const lv_font_t * font, uint32_t gid)
+{
+    const lv_font_fmt_txt_dsc_t * fdsc = (const lv_font_fmt_txt_dsc_t *)font->dsc;
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+    const uint8_t * bitmap = &fdsc->glyph_bitmap[gdsc->bitmap_index];
+    uint32_t size = ((uint32_t)gdsc->box_w * gdsc->box_h * fdsc->bpp + 7) >> 3;
+    if(size == 0) return bitmap;
+
+    uint32_t i;
+    for(i = 0; i < LV_FONT_FMT_TXT_SRAM_CACHE_FONTS; i++) {
+        if(sram_fonts[i] == font) break;
+    }
+    if(i == LV_FONT_FMT_TXT_SRAM_CACHE_FONTS) return bitmap;
+
+    for(i = 0; i < sram_stats.glyphs; i++) {
+        if(sram_glyphs[i].gid == gid && sram_glyphs[i].font == font) {
+            sram_stats.hits++;
+            return sram_glyphs[i].bitmap;
+        }
+    }
+
+    sram_stats.misses++;
+    sram_stats.font_bytes += size;
+
+    if(sram_stats.glyphs >= LV_FONT_FMT_TXT_SRAM_CACHE_GLYPHS ||
+       sram_stats.used + size > LV_FONT_FMT_TXT_SRAM_CACHE_SIZE) {
+        return bitmap;
+    }
+
+    uint8_t * copy = &sram_pool[sram_stats.used];
+    lv_memcpy(copy, bitmap, size);
+    sram_stats.used += size;
+
+    sram_glyphs[sram_stats.glyphs].font = font;
+    sram_glyphs[sram_stats.glyphs].gid = gid;
+    sram_glyphs[sram_stats.glyphs].bitmap = copy;
+    sram_stats.glyphs++;
+    return copy;
+}
+#endif
+
 #if LV_USE_FONT_COMPRESSED
+
+#if LV_FONT_FMT_TXT_DECOMPR_CACHE_SIZE
+/**
+ * Get a decompressed glyph from the LRU cache, decompress and add it on a miss.
+ * Least recently used glyphs are dropped to make room before allocating the new one.
+ * @param font pointer to a compressed font
+ * @param gid glyph id
+ * @param buf_size size of the decompressed bitmap
+ * @return the decompressed bitmap or NULL if it can't be cached
+ */
+static const uint8_t * decompr_cache_get(const lv_font_t * font, uint32_t gid, uint32_t buf_size)
+{
+    if(buf_size > LV_FONT_FMT_TXT_DECOMPR_CACHE_SIZE) return NULL;
+
+    lv_lru_t * cache = LV_GC_ROOT(_lv_font_decompr_cache);
+    if(cache == NULL) {
+        cache = lv_lru_create(LV_FONT_FMT_TXT_DECOMPR_CACHE_SIZE, DECOMPR_CACHE_AVG_GLYPH, decompr_cache_free, NULL);
+        if(cache == NULL) return NULL;
+        LV_GC_ROOT(_lv_font_decompr_cache) = cache;
+    }
+
+    /*Zero the padding too, the key is hashed and compared as bytes*/
+    decompr_key_t key;
+    lv_memset_00(&key, sizeof(key));
+    key.font = font;
+    key.gid = gid;
+
+    void * bitmap;
+    lv_lru_get(cache, &key, sizeof(key), &bitmap);
+    if(bitmap) {
+        decompr_stats.hits++;
+        return bitmap;
+    }
+
+    while(cache->free_memory < buf_size) lv_lru_remove_lru_item(cache);
+
+    bitmap = lv_mem_alloc(buf_size);
+    if(bitmap == NULL) return NULL;
+
+    const lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+    bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
+    decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], bitmap, gdsc->box_w, gdsc->box_h, (uint8_t)fdsc->bpp, prefilter);
+
+    if(lv_lru_set(cache, &key, sizeof(key), bitmap, buf_size) != LV_LRU_OK) {
+        lv_mem_free(bitmap);
+        return NULL;
+    }
+    decompr_stats.misses++;
+    decompr_stats.glyphs++;
+    return bitmap;
+}
+
+static void decompr_cache_free(void * bitmap)
+{
+    decompr_stats.glyphs--;
+    lv_mem_free(bitmap);
+}
+#endif /*LV_FONT_FMT_TXT_DECOMPR_CACHE_SIZE*/
+
 /**
  * The compress a glyph's bitmap
  * @param in the compressed bitmap
@@ -503,7 +914,7 @@ static inline void bits_write(uint8_t * out, uint32_t bit_pos, uint8_t val, uint
     bit_pos = 8 - bit_pos - len;
 
     uint8_t bit_mask = (uint16_t)((uint16_t) 1 << len) - 1;
-    out[byte_pos] &= ((~bit_mask) << bit_pos);
+    out[byte_pos] &= (uint8_t)((uint8_t)~bit_mask << bit_pos);
     out[byte_pos] |= (val << bit_pos);
 }
 
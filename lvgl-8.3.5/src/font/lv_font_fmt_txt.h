@@ -151,9 +151,48 @@ typedef enum {
     LV_FONT_FMT_TXT_COMPRESSED_NO_PREFILTER = 1,
 } lv_font_fmt_txt_bitmap_format_t;
 
+#if LV_FONT_FMT_TXT_GID_CACHE_SIZE & (LV_FONT_FMT_TXT_GID_CACHE_SIZE - 1)
+#error "LV_FONT_FMT_TXT_GID_CACHE_SIZE must be a power of 2"
+#endif
+
+#if LV_FONT_FMT_TXT_KERN_CACHE_SIZE & (LV_FONT_FMT_TXT_KERN_CACHE_SIZE - 1)
+#error "LV_FONT_FMT_TXT_KERN_CACHE_SIZE must be a power of 2"
+#endif
+
+#define LV_FONT_FMT_TXT_GID_ASCII_FIRST 0x20
+#define LV_FONT_FMT_TXT_GID_ASCII_LAST  0x7F
+#define LV_FONT_FMT_TXT_GID_ASCII_CNT   (LV_FONT_FMT_TXT_GID_ASCII_LAST - LV_FONT_FMT_TXT_GID_ASCII_FIRST + 1)
+
+typedef struct {
+    uint32_t letter;        /*0: empty entry*/
+    uint32_t glyph_id;
+} lv_font_fmt_txt_gid_cache_entry_t;
+
+typedef struct {
+    uint16_t gid_left;      /*0: empty entry*/
+    uint16_t gid_right;
+    int8_t value;
+} lv_font_fmt_txt_kern_cache_entry_t;
+
 typedef struct {
     uint32_t last_letter;
     uint32_t last_glyph_id;
+#if LV_FONT_FMT_TXT_GID_CACHE_SIZE
+    /*Indexed by a hash of the letter*/
+    lv_font_fmt_txt_gid_cache_entry_t entries[LV_FONT_FMT_TXT_GID_CACHE_SIZE];
+#endif
+#if LV_FONT_FMT_TXT_GID_ASCII
+    uint16_t ascii[LV_FONT_FMT_TXT_GID_ASCII_CNT];
+    uint8_t ascii_state;    /*0: not filled yet, 1: filled, 2: not used for this font*/
+#endif
+#if LV_FONT_FMT_TXT_KERN_ASCII_MEM
+    int8_t * kern_ascii;    /*Kerning values of the ASCII pairs as [left][right], allocated on first use*/
+    uint8_t kern_ascii_state;   /*0: not built yet, 1: built, 2: not used for this font*/
+#endif
+#if LV_FONT_FMT_TXT_KERN_CACHE_SIZE
+    /*Indexed by a hash of the glyph IDs*/
+    lv_font_fmt_txt_kern_cache_entry_t kern[LV_FONT_FMT_TXT_KERN_CACHE_SIZE];
+#endif
 } lv_font_fmt_txt_glyph_cache_t;
 
 /*Describe store additional data for fonts*/
@@ -197,6 +236,42 @@ typedef struct {
     lv_font_fmt_txt_glyph_cache_t * cache;
 } lv_font_fmt_txt_dsc_t;
 
+#if LV_FONT_FMT_TXT_SRAM_CACHE_SIZE
+typedef struct {
+    uint32_t hits;          /*Bitmaps returned from the RAM pool*/
+    uint32_t misses;        /*Bitmaps of registered fonts returned from the font itself*/
+    uint32_t font_bytes;    /*Size of the bitmaps returned from the font itself*/
+    uint16_t glyphs;        /*Glyphs copied to the RAM pool*/
+    uint32_t used;          /*Bytes used in the RAM pool*/
+} lv_font_fmt_txt_sram_cache_stats_t;
+#endif
+
+#if LV_FONT_FMT_TXT_GID_CACHE_SIZE || LV_FONT_FMT_TXT_GID_ASCII
+typedef struct {
+    uint32_t ascii_hits;    /*Glyph IDs read from the ASCII table*/
+    uint32_t hits;          /*Glyph IDs found in the direct-mapped cache*/
+    uint32_t misses;        /*Glyph IDs searched in the cmaps*/
+} lv_font_fmt_txt_gid_cache_stats_t;
+#endif
+
+#if LV_FONT_FMT_TXT_KERN_ASCII_MEM || LV_FONT_FMT_TXT_KERN_CACHE_SIZE
+typedef struct {
+    uint32_t ascii_hits;    /*Kerning values read from the ASCII tables*/
+    uint32_t hits;          /*Kerning values found in the pair caches*/
+    uint32_t misses;        /*Kerning values looked up in the font*/
+    uint32_t ascii_used;    /*Bytes allocated for the ASCII tables*/
+} lv_font_fmt_txt_kern_stats_t;
+#endif
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_DECOMPR_CACHE_SIZE
+typedef struct {
+    uint32_t hits;          /*Bitmaps returned already decompressed*/
+    uint32_t misses;        /*Bitmaps decompressed and added to the cache*/
+    uint32_t glyphs;        /*Glyphs in the cache now*/
+    uint32_t used;          /*Bytes of decompressed bitmaps in the cache now*/
+} lv_font_fmt_txt_decompr_cache_stats_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -222,9 +297,63 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
 
 /**
  * Free the allocated memories.
+ * The decompressed glyph cache is kept.
  */
 void _lv_font_clean_up_fmt_txt(void);
 
+#if LV_FONT_FMT_TXT_SRAM_CACHE_SIZE
+/**
+ * Copy the bitmaps of the font's glyphs into the RAM pool when they are first used.
+ * Only uncompressed fonts can be cached.
+ * @param font pointer to a font using `lv_font_get_bitmap_fmt_txt`
+ * @return true: the font is registered; false: not supported or no free font slot
+ */
+bool lv_font_fmt_txt_sram_cache_add(const lv_font_t * font);
+
+/**
+ * Get the statistics of the RAM glyph cache.
+ * @param stats store the result here
+ */
+void lv_font_fmt_txt_sram_cache_get_stats(lv_font_fmt_txt_sram_cache_stats_t * stats);
+#endif
+
+#if LV_FONT_FMT_TXT_GID_CACHE_SIZE || LV_FONT_FMT_TXT_GID_ASCII
+/**
+ * Get the hit counters of the glyph ID lookup cache, summed over all fonts.
+ * @param stats store the result here
+ */
+void lv_font_fmt_txt_gid_cache_get_stats(lv_font_fmt_txt_gid_cache_stats_t * stats);
+#endif
+
+#if LV_FONT_FMT_TXT_KERN_ASCII_MEM || LV_FONT_FMT_TXT_KERN_CACHE_SIZE
+/**
+ * Free the kerning lookup tables of a font and reset its pair cache.
+ * Call it before freeing a font which has a `cache`.
+ * @param font pointer to a font using `lv_font_get_glyph_dsc_fmt_txt`
+ */
+void lv_font_fmt_txt_kern_accel_free(const lv_font_t * font);
+
+/**
+ * Get the hit counters of the kerning lookup acceleration, summed over all fonts.
+ * @param stats store the result here
+ */
+void lv_font_fmt_txt_kern_get_stats(lv_font_fmt_txt_kern_stats_t * stats);
+#endif
+
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_DECOMPR_CACHE_SIZE
+/**
+ * Drop all decompressed glyphs. Call it before freeing a compressed font
+ * as the glyphs are identified by the font's address.
+ */
+void lv_font_fmt_txt_decompr_cache_clear(void);
+
+/**
+ * Get the statistics of the decompressed glyph cache.
+ * @param stats store the result here
+ */
+void lv_font_fmt_txt_decompr_cache_get_stats(lv_font_fmt_txt_decompr_cache_stats_t * stats);
+#endif
+
 /**********************
  *      MACROS
  **********************/
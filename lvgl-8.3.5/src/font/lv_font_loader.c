@@ -60,6 +60,15 @@ typedef struct cmap_table_bin {
     uint8_t padding;
 } cmap_table_bin_t;
 
+/*A font used in place from a binary font image, allocated in one block*/
+typedef struct {
+    lv_font_t font;
+    lv_font_fmt_txt_dsc_t dsc;
+    lv_font_fmt_txt_glyph_cache_t cache;
+    const uint8_t * image;
+    uint32_t size;
+} mapped_font_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -70,6 +79,20 @@ int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t f
 static int read_bits_signed(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
 static unsigned int read_bits(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
 
+static bool mapped_load_font(mapped_font_t * mf);
+static int32_t mapped_load_cmaps(mapped_font_t * mf, uint32_t start);
+static bool mapped_check_cmaps(const mapped_font_t * mf, uint32_t glyph_cnt);
+static int32_t mapped_load_glyphs(mapped_font_t * mf, const font_header_bin_t * header, uint32_t start,
+                                  const uint8_t * loca, uint32_t loca_count);
+static int32_t mapped_load_kern(mapped_font_t * mf, uint8_t format, uint32_t start, uint32_t glyph_cnt);
+static int32_t mapped_label(const mapped_font_t * mf, uint32_t start, const char * label);
+static const void * mapped_array(const mapped_font_t * mf, uint32_t ofs, uint32_t len, uint8_t align);
+static void mapped_free(const mapped_font_t * mf, const void * p);
+static uint32_t mapped_read_bits(const uint8_t * p, uint32_t * bit_pos, uint8_t n_bits);
+static int32_t mapped_read_bits_signed(const uint8_t * p, uint32_t * bit_pos, uint8_t n_bits);
+static uint16_t mapped_u16(const uint8_t * p);
+static uint32_t mapped_u32(const uint8_t * p);
+
 /**********************
  *      MACROS
  **********************/
@@ -119,7 +142,16 @@ void lv_font_free(lv_font_t * font)
     if(NULL != font) {
         lv_font_fmt_txt_dsc_t * dsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
+#if LV_USE_LABEL && LV_LABEL_LAYOUT_CACHE
+        /*The labels identify the measured fonts by their address which can be reused*/
+        _lv_label_layout_cache_font_freed(font);
+#endif
+
         if(NULL != dsc) {
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_DECOMPR_CACHE_SIZE
+            /*Decompressed glyphs are identified by the font's address which can be reused*/
+            if(dsc->bitmap_format != LV_FONT_FMT_TXT_PLAIN) lv_font_fmt_txt_decompr_cache_clear();
+#endif
 
             if(dsc->kern_classes == 0) {
                 lv_font_fmt_txt_kern_pair_t * kern_dsc =
@@ -178,6 +210,91 @@ void lv_font_free(lv_font_t * font)
     }
 }
 
+/**
+ * Create a font from a binary font image which stays in memory, e.g. in XIP flash.
+ * The glyph bitmaps, cmap lists and kerning tables are used in place,
+ * only the glyph descriptors and a few small headers are allocated.
+ * The advance width, position and size bits of the glyph headers have to add up to
+ * a multiple of 8, so that the bitmaps start on a byte boundary.
+ * Lists of 16 bit values which are not 2 byte aligned in the image are copied.
+ * @param image pointer to the font image, it has to stay valid until the font is freed
+ * @param size size of the image in bytes
+ * @return a pointer to the font or NULL in case of error
+ */
+lv_font_t * lv_font_load_mapped(const void * image, uint32_t size)
+{
+    mapped_font_t * mf = lv_mem_alloc(sizeof(mapped_font_t));
+    if(mf == NULL) return NULL;
+
+    memset(mf, 0, sizeof(mapped_font_t));
+    mf->image = image;
+    mf->size = size;
+    mf->font.dsc = &mf->dsc;
+    mf->dsc.cache = &mf->cache;
+
+    if(!mapped_load_font(mf)) {
+        LV_LOG_WARN("Error loading mapped font image: %p", image);
+        lv_font_free_mapped(&mf->font);
+        return NULL;
+    }
+
+    return &mf->font;
+}
+
+/**
+ * Frees the memory allocated by the `lv_font_load_mapped()` function.
+ * The font image itself is not touched.
+ * @param font lv_font_t object created by the lv_font_load_mapped function
+ */
+void lv_font_free_mapped(lv_font_t * font)
+{
+    if(NULL == font) return;
+
+    mapped_font_t * mf = (mapped_font_t *)font;
+    lv_font_fmt_txt_dsc_t * dsc = &mf->dsc;
+
+#if LV_USE_LABEL && LV_LABEL_LAYOUT_CACHE
+    /*The labels identify the measured fonts by their address which can be reused*/
+    _lv_label_layout_cache_font_freed(font);
+#endif
+#if LV_USE_FONT_COMPRESSED && LV_FONT_FMT_TXT_DECOMPR_CACHE_SIZE
+    /*Decompressed glyphs are identified by the font's address which can be reused*/
+    if(dsc->bitmap_format != LV_FONT_FMT_TXT_PLAIN) lv_font_fmt_txt_decompr_cache_clear();
+#endif
+#if LV_FONT_FMT_TXT_KERN_ASCII_MEM || LV_FONT_FMT_TXT_KERN_CACHE_SIZE
+    lv_font_fmt_txt_kern_accel_free(font);
+#endif
+
+    if(NULL != dsc->kern_dsc) {
+        if(dsc->kern_classes == 0) {
+            const lv_font_fmt_txt_kern_pair_t * kern_dsc = dsc->kern_dsc;
+            mapped_free(mf, kern_dsc->glyph_ids);
+            mapped_free(mf, kern_dsc->values);
+        }
+        else {
+            const lv_font_fmt_txt_kern_classes_t * kern_dsc = dsc->kern_dsc;
+            mapped_free(mf, kern_dsc->class_pair_values);
+            mapped_free(mf, kern_dsc->left_class_mapping);
+            mapped_free(mf, kern_dsc->right_class_mapping);
+        }
+        lv_mem_free((void *)dsc->kern_dsc);
+    }
+
+    if(NULL != dsc->cmaps) {
+        for(int i = 0; i < dsc->cmap_num; ++i) {
+            mapped_free(mf, dsc->cmaps[i].unicode_list);
+            mapped_free(mf, dsc->cmaps[i].glyph_id_ofs_list);
+        }
+        lv_mem_free((void *)dsc->cmaps);
+    }
+
+    if(NULL != dsc->glyph_dsc) {
+        lv_mem_free((void *)dsc->glyph_dsc);
+    }
+
+    lv_mem_free(mf);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -205,9 +322,10 @@ static unsigned int read_bits(bit_iterator_t * it, int n_bits, lv_fs_res_t * res
                 return 0;
             }
         }
-        int8_t bit = (it->byte_value & 0x80) ? 1 : 0;
+        unsigned int bit = (it->byte_value & 0x80) ? 1 : 0;
 
-        value |= (bit << n_bits);
+        /*Longer reads only skip bits (e.g. the glyph header), keep the low bits only*/
+        if(n_bits < (int)(sizeof(value) * 8)) value |= (bit << n_bits);
     }
     *res = LV_FS_RES_OK;
     return value;
@@ -679,3 +797,459 @@ int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t f
 
     return kern_length;
 }
+
+/*
+ * Same layout as `lvgl_load_font` but reading the image directly.
+ * Every pointer set on the font is either inside the image or allocated,
+ * `lv_font_free_mapped` tells them apart by the address.
+ */
+static bool mapped_load_font(mapped_font_t * mf)
+{
+    lv_font_t * font = &mf->font;
+    lv_font_fmt_txt_dsc_t * font_dsc = &mf->dsc;
+
+    /*header*/
+    int32_t header_length = mapped_label(mf, 0, "head");
+    if(header_length < (int32_t)(8 + sizeof(font_header_bin_t))) {
+        return false;
+    }
+
+    font_header_bin_t font_header;
+    memcpy(&font_header, mf->image + 8, sizeof(font_header_bin_t));
+
+    font->base_line = -font_header.descent;
+    font->line_height = font_header.ascent - font_header.descent;
+    font->get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
+    font->get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+    font->subpx = font_header.subpixels_mode;
+    font->underline_position = font_header.underline_position;
+    font->underline_thickness = font_header.underline_thickness;
+
+    font_dsc->bpp = font_header.bits_per_pixel;
+    font_dsc->kern_scale = font_header.kerning_scale;
+    font_dsc->bitmap_format = font_header.compression_id;
+
+    /*cmaps*/
+    uint32_t cmaps_start = header_length;
+    int32_t cmaps_length = mapped_load_cmaps(mf, cmaps_start);
+    if(cmaps_length < 0) {
+        return false;
+    }
+
+    /*loca*/
+    uint32_t loca_start = cmaps_start + cmaps_length;
+    int32_t loca_length = mapped_label(mf, loca_start, "loca");
+    if(loca_length < 12) {
+        return false;
+    }
+
+    if(font_header.index_to_loc_format > 1) {
+        LV_LOG_WARN("Unknown index_to_loc_format: %d.", font_header.index_to_loc_format);
+        return false;
+    }
+
+    uint32_t loca_count = mapped_u32(mf->image + loca_start + 8);
+    uint32_t offset_size = font_header.index_to_loc_format == 0 ? sizeof(uint16_t) : sizeof(uint32_t);
+    if(loca_count == 0 || loca_count > (loca_length - 12) / offset_size) {
+        return false;
+    }
+
+    /*The cmaps come before the loca table, their glyph IDs can be checked only now*/
+    if(!mapped_check_cmaps(mf, loca_count)) {
+        return false;
+    }
+
+    /*glyph*/
+    uint32_t glyph_start = loca_start + loca_length;
+    int32_t glyph_length = mapped_load_glyphs(mf, &font_header, glyph_start, mf->image + loca_start + 12, loca_count);
+    if(glyph_length < 0) {
+        return false;
+    }
+
+    if(font_header.tables_count < 4) {
+        font_dsc->kern_dsc = NULL;
+        font_dsc->kern_classes = 0;
+        font_dsc->kern_scale = 0;
+        return true;
+    }
+
+    uint32_t kern_start = glyph_start + glyph_length;
+    return mapped_load_kern(mf, font_header.glyph_id_format, kern_start, loca_count) >= 0;
+}
+
+static int32_t mapped_load_cmaps(mapped_font_t * mf, uint32_t start)
+{
+    int32_t cmaps_length = mapped_label(mf, start, "cmap");
+    if(cmaps_length < 12) {
+        return -1;
+    }
+
+    uint32_t cmaps_subtables_count = mapped_u32(mf->image + start + 8);
+    if(cmaps_subtables_count == 0 || cmaps_subtables_count >= (1 << 9) ||
+       cmaps_subtables_count > (cmaps_length - 12) / sizeof(cmap_table_bin_t)) {
+        return -1;
+    }
+
+    lv_font_fmt_txt_cmap_t * cmaps = lv_mem_alloc(cmaps_subtables_count * sizeof(lv_font_fmt_txt_cmap_t));
+    if(cmaps == NULL) {
+        return -1;
+    }
+
+    memset(cmaps, 0, cmaps_subtables_count * sizeof(lv_font_fmt_txt_cmap_t));
+
+    mf->dsc.cmaps = cmaps;
+    mf->dsc.cmap_num = cmaps_subtables_count;
+
+    for(unsigned int i = 0; i < cmaps_subtables_count; ++i) {
+        cmap_table_bin_t cmap_table;
+        memcpy(&cmap_table, mf->image + start + 12 + i * sizeof(cmap_table_bin_t), sizeof(cmap_table_bin_t));
+
+        lv_font_fmt_txt_cmap_t * cmap = &cmaps[i];
+        cmap->range_start = cmap_table.range_start;
+        cmap->range_length = cmap_table.range_length;
+        cmap->glyph_id_start = cmap_table.glyph_id_start;
+        cmap->type = cmap_table.format_type;
+
+        uint32_t data = start + cmap_table.data_offset;
+        uint32_t entries = cmap_table.data_entries_count;
+
+        switch(cmap_table.format_type) {
+            case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL:
+                /*The list is indexed with the code point's offset in the range*/
+                if(entries < cmap->range_length) {
+                    LV_LOG_WARN("cmap %d has %d entries for a range of %d.", (int)i, (int)entries, (int)cmap->range_length);
+                    return -1;
+                }
+                cmap->glyph_id_ofs_list = mapped_array(mf, data, entries, sizeof(uint8_t));
+                if(cmap->glyph_id_ofs_list == NULL) {
+                    return -1;
+                }
+                cmap->list_length = cmap->range_length;
+                break;
+            case LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY:
+                break;
+            case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL:
+            case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY:
+                cmap->unicode_list = mapped_array(mf, data, entries * sizeof(uint16_t), sizeof(uint16_t));
+                if(cmap->unicode_list == NULL) {
+                    return -1;
+                }
+                cmap->list_length = entries;
+
+                if(cmap_table.format_type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
+                    cmap->glyph_id_ofs_list = mapped_array(mf, data + entries * sizeof(uint16_t),
+                                                           entries * sizeof(uint16_t), sizeof(uint16_t));
+                    if(cmap->glyph_id_ofs_list == NULL) {
+                        return -1;
+                    }
+                }
+                break;
+            default:
+                LV_LOG_WARN("Unknown cmaps format type %d.", cmap_table.format_type);
+                return -1;
+        }
+    }
+
+    return cmaps_length;
+}
+
+/**
+ * Check that every glyph ID the cmaps can give is a glyph of the font.
+ * @param glyph_cnt number of glyphs in the loca table
+ */
+static bool mapped_check_cmaps(const mapped_font_t * mf, uint32_t glyph_cnt)
+{
+    for(uint32_t i = 0; i < mf->dsc.cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &mf->dsc.cmaps[i];
+        uint32_t max_ofs = 0;
+
+        switch(cmap->type) {
+            case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL: {
+                    const uint8_t * ofs = cmap->glyph_id_ofs_list;
+                    for(uint32_t j = 0; j < cmap->range_length; j++) max_ofs = LV_MAX(max_ofs, ofs[j]);
+                    break;
+                }
+            case LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY:
+                max_ofs = cmap->range_length ? cmap->range_length - 1 : 0;
+                break;
+            case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY:
+                max_ofs = cmap->list_length ? cmap->list_length - 1 : 0;
+                break;
+            case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL: {
+                    const uint16_t * ofs = cmap->glyph_id_ofs_list;
+                    for(uint32_t j = 0; j < cmap->list_length; j++) max_ofs = LV_MAX(max_ofs, ofs[j]);
+                    break;
+                }
+        }
+
+        if(cmap->glyph_id_start + max_ofs >= glyph_cnt) {
+            LV_LOG_WARN("cmap %d maps to glyph %d, the font has %d glyphs.", (int)i,
+                        (int)(cmap->glyph_id_start + max_ofs), (int)glyph_cnt);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static int32_t mapped_load_glyphs(mapped_font_t * mf, const font_header_bin_t * header, uint32_t start,
+                                  const uint8_t * loca, uint32_t loca_count)
+{
+    int32_t glyph_length = mapped_label(mf, start, "glyf");
+    if(glyph_length < 0) {
+        return -1;
+    }
+
+    uint32_t nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
+    if(nbits % 8 != 0) {
+        LV_LOG_WARN("Glyph headers are %d bits long, the bitmaps are not byte aligned and can't be used in place.",
+                    (int)nbits);
+        return -1;
+    }
+
+    lv_font_fmt_txt_glyph_dsc_t * glyph_dsc = lv_mem_alloc(loca_count * sizeof(lv_font_fmt_txt_glyph_dsc_t));
+    if(glyph_dsc == NULL) {
+        return -1;
+    }
+
+    memset(glyph_dsc, 0, loca_count * sizeof(lv_font_fmt_txt_glyph_dsc_t));
+
+    mf->dsc.glyph_dsc = glyph_dsc;
+    mf->dsc.glyph_bitmap = mf->image + start;
+
+    for(uint32_t i = 1; i < loca_count; ++i) {
+        uint32_t offset = header->index_to_loc_format == 0 ? mapped_u16(&loca[i * 2]) : mapped_u32(&loca[i * 4]);
+        uint32_t next_offset = (uint32_t)glyph_length;
+        if(i < loca_count - 1) {
+            next_offset = header->index_to_loc_format == 0 ? mapped_u16(&loca[(i + 1) * 2]) : mapped_u32(&loca[(i + 1) * 4]);
+        }
+
+        if(offset + nbits / 8 > next_offset || next_offset > (uint32_t)glyph_length) {
+            LV_LOG_WARN("Glyph %d is out of the glyf table.", (int)i);
+            return -1;
+        }
+
+        lv_font_fmt_txt_glyph_dsc_t * gdsc = &glyph_dsc[i];
+        const uint8_t * glyph = mf->image + start + offset;
+        uint32_t bit_pos = 0;
+
+        if(header->advance_width_bits == 0) {
+            gdsc->adv_w = header->default_advance_width;
+        }
+        else {
+            gdsc->adv_w = mapped_read_bits(glyph, &bit_pos, header->advance_width_bits);
+        }
+
+        if(header->advance_width_format == 0) {
+            gdsc->adv_w *= 16;
+        }
+
+        gdsc->ofs_x = mapped_read_bits_signed(glyph, &bit_pos, header->xy_bits);
+        gdsc->ofs_y = mapped_read_bits_signed(glyph, &bit_pos, header->xy_bits);
+        gdsc->box_w = mapped_read_bits(glyph, &bit_pos, header->wh_bits);
+        gdsc->box_h = mapped_read_bits(glyph, &bit_pos, header->wh_bits);
+
+        /*The bitmap follows the header in the image*/
+        uint32_t bitmap_index = offset + nbits / 8;
+        gdsc->bitmap_index = bitmap_index;
+        if(gdsc->bitmap_index != bitmap_index) {
+            LV_LOG_WARN("The glyf table is too large, enable LV_FONT_FMT_TXT_LARGE.");
+            return -1;
+        }
+
+        if(header->compression_id == LV_FONT_FMT_TXT_PLAIN &&
+           ((uint32_t)gdsc->box_w * gdsc->box_h * header->bits_per_pixel + 7) / 8 > next_offset - bitmap_index) {
+            LV_LOG_WARN("The bitmap of glyph %d is truncated.", (int)i);
+            return -1;
+        }
+    }
+
+    return glyph_length;
+}
+
+/**
+ * @param glyph_cnt number of glyphs in the loca table, the kerning data can't refer to other glyphs
+ */
+static int32_t mapped_load_kern(mapped_font_t * mf, uint8_t format, uint32_t start, uint32_t glyph_cnt)
+{
+    int32_t kern_length = mapped_label(mf, start, "kern");
+    if(kern_length < 16) {
+        return -1;
+    }
+
+    const uint8_t * kern = mf->image + start + 8;
+    uint8_t kern_format_type = kern[0];
+
+    if(0 == kern_format_type) { /*sorted pairs*/
+        lv_font_fmt_txt_kern_pair_t * kern_pair = lv_mem_alloc(sizeof(lv_font_fmt_txt_kern_pair_t));
+        if(kern_pair == NULL) {
+            return -1;
+        }
+
+        memset(kern_pair, 0, sizeof(lv_font_fmt_txt_kern_pair_t));
+
+        mf->dsc.kern_dsc = kern_pair;
+        mf->dsc.kern_classes = 0;
+
+        uint32_t glyph_entries = mapped_u32(&kern[4]);
+        uint8_t id_size = format == 0 ? sizeof(int8_t) : sizeof(int16_t);
+        if(glyph_entries > mf->size / (2 * id_size + 1)) {
+            return -1;
+        }
+
+        uint32_t ids_size = 2 * id_size * glyph_entries;
+
+        kern_pair->glyph_ids_size = format;
+        kern_pair->pair_cnt = glyph_entries;
+        kern_pair->glyph_ids = mapped_array(mf, start + 16, ids_size, id_size);
+        kern_pair->values = mapped_array(mf, start + 16 + ids_size, glyph_entries, sizeof(int8_t));
+
+        if(kern_pair->glyph_ids == NULL || kern_pair->values == NULL) {
+            return -1;
+        }
+
+        for(uint32_t i = 0; i < 2 * glyph_entries; i++) {
+            uint32_t id = format == 0 ? ((const uint8_t *)kern_pair->glyph_ids)[i] :
+                          ((const uint16_t *)kern_pair->glyph_ids)[i];
+            if(id >= glyph_cnt) {
+                LV_LOG_WARN("Kerning pair %d refers to glyph %d, the font has %d glyphs.", (int)(i / 2), (int)id,
+                            (int)glyph_cnt);
+                return -1;
+            }
+        }
+    }
+    else if(3 == kern_format_type) { /*array M*N of classes*/
+        lv_font_fmt_txt_kern_classes_t * kern_classes = lv_mem_alloc(sizeof(lv_font_fmt_txt_kern_classes_t));
+        if(kern_classes == NULL) {
+            return -1;
+        }
+
+        memset(kern_classes, 0, sizeof(lv_font_fmt_txt_kern_classes_t));
+
+        mf->dsc.kern_dsc = kern_classes;
+        mf->dsc.kern_classes = 1;
+
+        uint16_t kern_class_mapping_length = mapped_u16(&kern[4]);
+        uint8_t kern_table_rows = kern[6];
+        uint8_t kern_table_cols = kern[7];
+
+        kern_classes->left_class_cnt = kern_table_rows;
+        kern_classes->right_class_cnt = kern_table_cols;
+        kern_classes->left_class_mapping = mapped_array(mf, start + 16, kern_class_mapping_length, sizeof(uint8_t));
+        kern_classes->right_class_mapping = mapped_array(mf, start + 16 + kern_class_mapping_length,
+                                                         kern_class_mapping_length, sizeof(uint8_t));
+        kern_classes->class_pair_values = mapped_array(mf, start + 16 + 2 * kern_class_mapping_length,
+                                                       kern_table_rows * kern_table_cols, sizeof(int8_t));
+
+        if(kern_classes->left_class_mapping == NULL || kern_classes->right_class_mapping == NULL ||
+           kern_classes->class_pair_values == NULL) {
+            return -1;
+        }
+
+        /*The mappings are indexed with glyph IDs, class 0 means no kerning*/
+        if(kern_class_mapping_length < glyph_cnt) {
+            LV_LOG_WARN("The kerning class mappings cover %d glyphs, the font has %d.", (int)kern_class_mapping_length,
+                        (int)glyph_cnt);
+            return -1;
+        }
+
+        for(uint32_t i = 0; i < kern_class_mapping_length; i++) {
+            if(kern_classes->left_class_mapping[i] > kern_table_rows ||
+               kern_classes->right_class_mapping[i] > kern_table_cols) {
+                LV_LOG_WARN("The kerning class of glyph %d is out of the class table.", (int)i);
+                return -1;
+            }
+        }
+    }
+    else {
+        LV_LOG_WARN("Unknown kern_format_type: %d", kern_format_type);
+        return -1;
+    }
+
+    return kern_length;
+}
+
+/**
+ * Check the label of a table in the image.
+ * @return the length of the table including the label or -1 if it's invalid
+ */
+static int32_t mapped_label(const mapped_font_t * mf, uint32_t start, const char * label)
+{
+    if(start > mf->size || mf->size - start < 8) {
+        LV_LOG_WARN("The '%s' label is out of the image.", label);
+        return -1;
+    }
+
+    uint32_t length = mapped_u32(mf->image + start);
+    if(memcmp(label, mf->image + start + 4, 4) != 0 || length < 8 || length > mf->size - start ||
+       length > INT32_MAX) {
+        LV_LOG_WARN("Error reading '%s' label.", label);
+        return -1;
+    }
+
+    return (int32_t)length;
+}
+
+/**
+ * Get an array of the image in place, or a copy of it if it's not aligned for its elements.
+ * @return pointer to the array or NULL if it's out of the image or out of memory
+ */
+static const void * mapped_array(const mapped_font_t * mf, uint32_t ofs, uint32_t len, uint8_t align)
+{
+    if(ofs > mf->size || len > mf->size - ofs) {
+        LV_LOG_WARN("An array is out of the image.");
+        return NULL;
+    }
+
+    /*Empty arrays are never read, but NULL means an error*/
+    if(len == 0) return mf->image;
+
+    const uint8_t * p = mf->image + ofs;
+    if(((lv_uintptr_t)p & (align - 1)) == 0) return p;
+
+    uint8_t * copy = lv_mem_alloc(len);
+    if(copy == NULL) return NULL;
+
+    memcpy(copy, p, len);
+    return copy;
+}
+
+/**
+ * Free an array returned by `mapped_array` if it was copied.
+ */
+static void mapped_free(const mapped_font_t * mf, const void * p)
+{
+    const uint8_t * p8 = p;
+    if(p8 == NULL || (p8 >= mf->image && p8 < mf->image + mf->size)) return;
+
+    lv_mem_free((void *)p);
+}
+
+static uint32_t mapped_read_bits(const uint8_t * p, uint32_t * bit_pos, uint8_t n_bits)
+{
+    uint32_t value = 0;
+    while(n_bits--) {
+        uint32_t pos = (*bit_pos)++;
+        value = (value << 1) | ((p[pos >> 3] >> (7 - (pos & 0x7))) & 0x1);
+    }
+    return value;
+}
+
+static int32_t mapped_read_bits_signed(const uint8_t * p, uint32_t * bit_pos, uint8_t n_bits)
+{
+    uint32_t value = mapped_read_bits(p, bit_pos, n_bits);
+    if(n_bits && (value & (1u << (n_bits - 1)))) {
+        value |= ~0u << n_bits;
+    }
+    return (int32_t)value;
+}
+
+static uint16_t mapped_u16(const uint8_t * p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t mapped_u32(const uint8_t * p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
@@ -29,6 +29,9 @@ extern "C" {
 lv_font_t * lv_font_load(const char * fontName);
 void lv_font_free(lv_font_t * font);
 
+lv_font_t * lv_font_load_mapped(const void * image, uint32_t size);
+void lv_font_free_mapped(lv_font_t * font);
+
 /**********************
  *      MACROS
  **********************/
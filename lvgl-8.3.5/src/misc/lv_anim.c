@@ -31,6 +31,9 @@
 static void anim_timer(lv_timer_t * param);
 static void anim_mark_list_change(void);
 static void anim_ready_handler(lv_anim_t * a);
+static lv_anim_t * anim_node_alloc(void);
+static void anim_node_unlink(lv_anim_t * a);
+static void anim_node_free(lv_anim_t * a);
 
 /**********************
  *  STATIC VARIABLES
@@ -39,6 +42,11 @@ static uint32_t last_timer_run;
 static bool anim_list_changed;
 static bool anim_run_round;
 static lv_timer_t * _lv_anim_tmr;
+#if LV_ANIM_POOL_SIZE
+static lv_anim_t * anim_pool_nodes[LV_ANIM_POOL_SIZE];
+static lv_ll_t anim_pool_ll;        /*Pooled nodes not used by any animation*/
+static lv_ll_t anim_release_ll;     /*Pooled nodes of deleted animations whose callbacks are still running*/
+#endif
 
 /**********************
  *      MACROS
@@ -57,6 +65,15 @@ static lv_timer_t * _lv_anim_tmr;
 void _lv_anim_core_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_anim_ll), sizeof(lv_anim_t));
+#if LV_ANIM_POOL_SIZE
+    /*Allocate the pooled nodes once, before the heap gets fragmented, and never free them*/
+    _lv_ll_init(&anim_pool_ll, sizeof(lv_anim_t));
+    _lv_ll_init(&anim_release_ll, sizeof(lv_anim_t));
+    for(uint32_t i = 0; i < LV_ANIM_POOL_SIZE; i++) {
+        anim_pool_nodes[i] = _lv_ll_ins_tail(&anim_pool_ll);
+        LV_ASSERT_MALLOC(anim_pool_nodes[i]);
+    }
+#endif
     _lv_anim_tmr = lv_timer_create(anim_timer, LV_DISP_DEF_REFR_PERIOD, NULL);
     anim_mark_list_change(); /*Turn off the animation timer*/
     anim_list_changed = false;
@@ -86,7 +103,7 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
     }
 
     /*Add the new animation to the animation linked list*/
-    lv_anim_t * new_anim = _lv_ll_ins_head(&LV_GC_ROOT(_lv_anim_ll));
+    lv_anim_t * new_anim = anim_node_alloc();
     LV_ASSERT_MALLOC(new_anim);
     if(new_anim == NULL) return NULL;
 
@@ -146,9 +163,9 @@ bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
         a_next = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
 
         if((a->var == var || var == NULL) && (a->exec_cb == exec_cb || exec_cb == NULL)) {
-            _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
+            anim_node_unlink(a);
             if(a->deleted_cb != NULL) a->deleted_cb(a);
-            lv_mem_free(a);
+            anim_node_free(a);
             anim_mark_list_change(); /*Read by `anim_timer`. It need to know if a delete occurred in
                                        the linked list*/
             del = true;
@@ -162,6 +179,16 @@ bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
 
 void lv_anim_del_all(void)
 {
+#if LV_ANIM_POOL_SIZE
+    /*Give the pooled nodes back, `_lv_ll_clear` frees only the others*/
+    lv_anim_t * a = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
+    while(a != NULL) {
+        lv_anim_t * a_next = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
+        anim_node_unlink(a);
+        anim_node_free(a);
+        a = a_next;
+    }
+#endif
     _lv_ll_clear(&LV_GC_ROOT(_lv_anim_ll));
     anim_mark_list_change();
 }
@@ -429,14 +456,14 @@ static void anim_ready_handler(lv_anim_t * a)
 
         /*Delete the animation from the list.
          * This way the `ready_cb` will see the animations like it's animation is ready deleted*/
-        _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
+        anim_node_unlink(a);
         /*Flag that the list has changed*/
         anim_mark_list_change();
 
         /*Call the callback function at the end*/
         if(a->ready_cb != NULL) a->ready_cb(a);
         if(a->deleted_cb != NULL) a->deleted_cb(a);
-        lv_mem_free(a);
+        anim_node_free(a);
     }
     /*If the animation is not deleted then restart it*/
     else {
@@ -468,3 +495,61 @@ static void anim_mark_list_change(void)
     else
         lv_timer_resume(_lv_anim_tmr);
 }
+
+#if LV_ANIM_POOL_SIZE
+static bool anim_node_is_pooled(const lv_anim_t * a)
+{
+    for(uint32_t i = 0; i < LV_ANIM_POOL_SIZE; i++) {
+        if(anim_pool_nodes[i] == a) return true;
+    }
+    return false;
+}
+#endif
+
+/**
+ * Add a new node to the head of the animation list.
+ * Uses a free pooled node if there is one, else allocates it.
+ * @return the new node or NULL if out of memory
+ */
+static lv_anim_t * anim_node_alloc(void)
+{
+#if LV_ANIM_POOL_SIZE
+    lv_anim_t * a = _lv_ll_get_head(&anim_pool_ll);
+    if(a != NULL) {
+        _lv_ll_chg_list(&anim_pool_ll, &LV_GC_ROOT(_lv_anim_ll), a, true);
+        return a;
+    }
+#endif
+    return _lv_ll_ins_head(&LV_GC_ROOT(_lv_anim_ll));
+}
+
+/**
+ * Remove a node from the animation list. It stays valid until `anim_node_free`,
+ * so animations started from the `ready_cb`/`deleted_cb` of `a` can't get the same node.
+ * @param a     the node to remove
+ */
+static void anim_node_unlink(lv_anim_t * a)
+{
+#if LV_ANIM_POOL_SIZE
+    if(anim_node_is_pooled(a)) {
+        _lv_ll_chg_list(&LV_GC_ROOT(_lv_anim_ll), &anim_release_ll, a, true);
+        return;
+    }
+#endif
+    _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
+}
+
+/**
+ * Release a node removed with `anim_node_unlink`: give it back to the pool or free it.
+ * @param a     the node to release
+ */
+static void anim_node_free(lv_anim_t * a)
+{
+#if LV_ANIM_POOL_SIZE
+    if(anim_node_is_pooled(a)) {
+        _lv_ll_chg_list(&anim_release_ll, &anim_pool_ll, a, true);
+        return;
+    }
+#endif
+    lv_mem_free(a);
+}
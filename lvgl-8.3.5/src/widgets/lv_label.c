@@ -27,6 +27,7 @@
 #define LV_LABEL_SCROLL_DELAY       300
 #define LV_LABEL_DOT_END_INV 0xFFFFFFFF
 #define LV_LABEL_HINT_HEIGHT_LIMIT 1024 /*Enable "hint" to buffer info about labels larger than this. (Speed up drawing)*/
+#define LV_LABEL_LAYOUT_FONTS 4 /*Number of fonts to remember whether their digits are interchangeable*/
 
 /**********************
  *      TYPEDEFS
@@ -42,6 +43,12 @@ static void draw_main(lv_event_t * e);
 
 static void lv_label_refr_text(lv_obj_t * obj);
 static void lv_label_revert_dots(lv_obj_t * label);
+static void lv_label_get_txt_size(lv_obj_t * obj, lv_point_t * size, const lv_font_t * font, lv_coord_t letter_space,
+                                  lv_coord_t line_space, lv_coord_t max_w, lv_text_flag_t flag);
+#if LV_LABEL_LAYOUT_CACHE
+    static bool layout_shape(const char * text, const lv_font_t * font, char * shape);
+    static bool font_digits_interchangeable(const lv_font_t * font);
+#endif
 
 static bool lv_label_set_dot_tmp(lv_obj_t * label, char * data, uint32_t len);
 static char * lv_label_get_dot_tmp(lv_obj_t * label);
@@ -62,6 +69,14 @@ const lv_obj_class_t lv_label_class = {
     .base_class = &lv_obj_class
 };
 
+#if LV_LABEL_LAYOUT_CACHE
+    static lv_label_layout_cache_stats_t layout_stats;
+    static uint16_t layout_font_gen;
+    static const lv_font_t * digits_fonts[LV_LABEL_LAYOUT_FONTS];
+    static bool digits_results[LV_LABEL_LAYOUT_FONTS];
+    static uint8_t digits_next;
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -681,6 +696,24 @@ void lv_label_cut_text(lv_obj_t * obj, uint32_t pos, uint32_t cnt)
     lv_label_refr_text(obj);
 }
 
+#if LV_LABEL_LAYOUT_CACHE
+void lv_label_get_layout_cache_stats(lv_label_layout_cache_stats_t * stats)
+{
+    *stats = layout_stats;
+}
+
+void _lv_label_layout_cache_font_freed(const lv_font_t * font)
+{
+    uint32_t i;
+    for(i = 0; i < LV_LABEL_LAYOUT_FONTS; i++) {
+        if(digits_fonts[i] == font) digits_fonts[i] = NULL;
+    }
+
+    /*Invalidate the entries of all labels at once, they are checked against the counter*/
+    layout_font_gen++;
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -776,7 +809,7 @@ static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
         if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) w = LV_COORD_MAX;
         else w = lv_obj_get_content_width(obj);
 
-        lv_txt_get_size(&size, label->text, font, letter_space, line_space, w, flag);
+        lv_label_get_txt_size(obj, &size, font, letter_space, line_space, w, flag);
 
         lv_point_t * self_size = lv_event_get_param(e);
         self_size->x = LV_MAX(self_size->x, size.x);
@@ -824,8 +857,8 @@ static void draw_main(lv_event_t * e)
     if((label->long_mode == LV_LABEL_LONG_SCROLL || label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR) &&
        (label_draw_dsc.align == LV_TEXT_ALIGN_CENTER || label_draw_dsc.align == LV_TEXT_ALIGN_RIGHT)) {
         lv_point_t size;
-        lv_txt_get_size(&size, label->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                        LV_COORD_MAX, flag);
+        lv_label_get_txt_size(obj, &size, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
+                              LV_COORD_MAX, flag);
         if(size.x > lv_area_get_width(&txt_coords)) {
             label_draw_dsc.align = LV_TEXT_ALIGN_LEFT;
         }
@@ -864,8 +897,8 @@ static void draw_main(lv_event_t * e)
 
     if(label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR) {
         lv_point_t size;
-        lv_txt_get_size(&size, label->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                        LV_COORD_MAX, flag);
+        lv_label_get_txt_size(obj, &size, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
+                              LV_COORD_MAX, flag);
 
         /*Draw the text again on label to the original to make a circular effect */
         if(size.x > lv_area_get_width(&txt_coords)) {
@@ -914,7 +947,7 @@ static void lv_label_refr_text(lv_obj_t * obj)
     if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
     if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
 
-    lv_txt_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
+    lv_label_get_txt_size(obj, &size, font, letter_space, line_space, max_w, flag);
 
     lv_obj_refresh_self_size(obj);
 
@@ -1270,5 +1303,125 @@ static void set_ofs_y_anim(void * obj, int32_t v)
     lv_obj_invalidate(obj);
 }
 
+/**
+ * Get the size of the label's text like `lv_txt_get_size`.
+ * The result is reused while the shape of the text and the parameters don't change.
+ */
+static void lv_label_get_txt_size(lv_obj_t * obj, lv_point_t * size, const lv_font_t * font, lv_coord_t letter_space,
+                                  lv_coord_t line_space, lv_coord_t max_w, lv_text_flag_t flag)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+
+#if LV_LABEL_LAYOUT_CACHE
+    lv_label_layout_cache_t * cache = &label->layout;
+    char shape[LV_LABEL_LAYOUT_CACHE_LEN];
+    if(layout_shape(label->text, font, shape)) {
+        uint32_t i;
+        if(strcmp(shape, cache->shape) != 0) {
+            strcpy(cache->shape, shape);
+            lv_memset_00(cache->entries, sizeof(cache->entries));
+            cache->next = 0;
+        }
+        else {
+            for(i = 0; i < LV_LABEL_LAYOUT_CACHE_ENTRIES; i++) {
+                lv_label_layout_t * e = &cache->entries[i];
+                if(e->font == font && e->font_gen == layout_font_gen && e->letter_space == letter_space &&
+                   e->line_space == line_space && e->max_w == max_w && e->flag == flag) {
+                    *size = e->size;
+                    layout_stats.hits++;
+                    return;
+                }
+            }
+        }
+
+        lv_txt_get_size(size, label->text, font, letter_space, line_space, max_w, flag);
+        layout_stats.misses++;
+
+        lv_label_layout_t * e = &cache->entries[cache->next];
+        cache->next = (cache->next + 1) % LV_LABEL_LAYOUT_CACHE_ENTRIES;
+        e->font = font;
+        e->font_gen = layout_font_gen;
+        e->letter_space = letter_space;
+        e->line_space = line_space;
+        e->max_w = max_w;
+        e->flag = flag;
+        e->size = *size;
+        return;
+    }
+#endif
+
+    lv_txt_get_size(size, label->text, font, letter_space, line_space, max_w, flag);
+}
+
+#if LV_LABEL_LAYOUT_CACHE
+/**
+ * Get the shape of a text: the text itself with the digits replaced by '0'
+ * if the text is printable ASCII and the digits of the font are interchangeable.
+ * @param text      the label's text
+ * @param font      the label's font
+ * @param shape     store the result here, `LV_LABEL_LAYOUT_CACHE_LEN` bytes
+ * @return          false: the text is too long to be cached
+ */
+static bool layout_shape(const char * text, const lv_font_t * font, char * shape)
+{
+    bool digits = false;
+    bool ascii = true;
+    uint32_t i;
+    for(i = 0; text[i] != '\0'; i++) {
+        if(i >= LV_LABEL_LAYOUT_CACHE_LEN - 1) return false;
+
+        uint8_t c = (uint8_t)text[i];
+        if(c >= '0' && c <= '9') digits = true;
+        else if((c < 0x20 && c != '\n' && c != '\r') || c > 0x7E) ascii = false;
+        shape[i] = text[i];
+    }
+    shape[i] = '\0';
+
+    if(digits && ascii && font_digits_interchangeable(font)) {
+        for(i = 0; shape[i] != '\0'; i++) {
+            if(shape[i] >= '0' && shape[i] <= '9') shape[i] = '0';
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Check that replacing a digit with another one can't change the width of an ASCII text:
+ * the digits must have the same width next to any ASCII character (kerning included),
+ * and any ASCII character must have the same width before any digit.
+ * The result of the last `LV_LABEL_LAYOUT_FONTS` fonts is remembered until the font is freed.
+ */
+static bool font_digits_interchangeable(const lv_font_t * font)
+{
+    uint32_t i;
+    for(i = 0; i < LV_LABEL_LAYOUT_FONTS; i++) {
+        if(digits_fonts[i] == font) return digits_results[i];
+    }
+
+    bool res = true;
+    uint32_t c;
+    for(c = 0; c <= 0x7E && res; c++) {
+        if(c != 0 && c != '\n' && c != '\r' && c < 0x20) continue;
+
+        uint16_t digit_w = lv_font_get_glyph_width(font, '0', c);
+        uint16_t before_w = c ? lv_font_get_glyph_width(font, c, '0') : 0;
+        uint32_t d;
+        for(d = '1'; d <= '9'; d++) {
+            if(lv_font_get_glyph_width(font, d, c) != digit_w ||
+               (c && lv_font_get_glyph_width(font, c, d) != before_w)) {
+                res = false;
+                break;
+            }
+        }
+    }
+
+    digits_fonts[digits_next] = font;
+    digits_results[digits_next] = res;
+    digits_next = (digits_next + 1) % LV_LABEL_LAYOUT_FONTS;
+    return res;
+}
+#endif
+
 
 #endif
@@ -31,6 +31,7 @@ extern "C" {
 #define LV_LABEL_DOT_NUM 3
 #define LV_LABEL_POS_LAST 0xFFFF
 #define LV_LABEL_TEXT_SELECTION_OFF LV_DRAW_LABEL_NO_TXT_SEL
+#define LV_LABEL_LAYOUT_CACHE_ENTRIES 2 /*The label is measured with its content width and without width limit too*/
 
 LV_EXPORT_CONST_INT(LV_LABEL_DOT_NUM);
 LV_EXPORT_CONST_INT(LV_LABEL_POS_LAST);
@@ -50,6 +51,30 @@ enum {
 };
 typedef uint8_t lv_label_long_mode_t;
 
+#if LV_LABEL_LAYOUT_CACHE
+typedef struct {
+    const lv_font_t * font;     /*NULL: empty entry*/
+    uint16_t font_gen;          /*Number of fonts freed before the measurement: the address may belong to a new font since*/
+    lv_coord_t letter_space;
+    lv_coord_t line_space;
+    lv_coord_t max_w;
+    lv_text_flag_t flag;
+    lv_point_t size;
+} lv_label_layout_t;
+
+typedef struct {
+    char shape[LV_LABEL_LAYOUT_CACHE_LEN];  /*The text the entries were measured for, with digits replaced by '0'
+                                              if the font's digits are interchangeable*/
+    lv_label_layout_t entries[LV_LABEL_LAYOUT_CACHE_ENTRIES];
+    uint8_t next;
+} lv_label_layout_cache_t;
+
+typedef struct {
+    uint32_t hits;              /*Measurements avoided*/
+    uint32_t misses;            /*Texts measured with `lv_txt_get_size`*/
+} lv_label_layout_cache_stats_t;
+#endif
+
 typedef struct {
     lv_obj_t obj;
     char * text;
@@ -68,6 +93,10 @@ typedef struct {
     uint32_t sel_end;
 #endif
 
+#if LV_LABEL_LAYOUT_CACHE
+    lv_label_layout_cache_t layout;
+#endif
+
     lv_point_t offset; /*Text draw position offset*/
     lv_label_long_mode_t long_mode : 3; /*Determine what to do with the long texts*/
     uint8_t static_txt : 1;             /*Flag to indicate the text is static*/
@@ -233,6 +262,22 @@ void lv_label_ins_text(lv_obj_t * obj, uint32_t pos, const char * txt);
  */
 void lv_label_cut_text(lv_obj_t * obj, uint32_t pos, uint32_t cnt);
 
+#if LV_LABEL_LAYOUT_CACHE
+/**
+ * Get the hit counters of the labels' layout cache, summed over all labels.
+ * @param stats     store the result here
+ */
+void lv_label_get_layout_cache_stats(lv_label_layout_cache_stats_t * stats);
+
+/**
+ * Forget what the labels remember about a font which is about to be freed,
+ * so a new font allocated at the same address isn't measured with the results of the old one.
+ * Called by `lv_font_free()` and `lv_font_free_mapped()`.
+ * @param font      the font to forget
+ */
+void _lv_label_layout_cache_font_freed(const lv_font_t * font);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -10,6 +10,7 @@
 #include <vector>
 #include <benchmark/lv_demo_benchmark.h>
 #include "ui.h"
+#include "ui_hw_slide.h"
 #include "InfoLabel.h"
 #include "INA219.h"
 #include "st7789.h"
@@ -68,7 +69,10 @@ int main() {
 
 	lv_init();
 	lv_port_disp_init();
+	ui_hw_slide_set_port(disp_slide_begin, disp_slide_set);
 	ui_init();
+	//端口数值标签每次刷新都要画十几个42px的8bpp字形，把用到的字形复制到SRAM，不再每次从XIP flash读
+	lv_font_fmt_txt_sram_cache_add(&ui_font_xlm_42);
 
 	// lv_demo_benchmark();
 	/*
@@ -110,8 +114,9 @@ static void refresh_data_cb(lv_timer_t * timer) {
 	//总线上的电压相差不大，电压label显示最后一个有效电压，如果全部失效，显示第一个电压
 	for (const auto info_label: arr_info_label) {
 		info_label->refresh_sensor_data();
-		info_label->set_label_text(info_label->fmt_info_str());
+		info_label->update_readout();
 		info_label->update_label_mask();
+		info_label->update_trend();
 		power_total += info_label->power_mw;
 
 		//当该接口的总线电压低于设定值时，隐藏其显示
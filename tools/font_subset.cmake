@@ -0,0 +1,48 @@
+# 构建时把ui/fonts里lv_font_conv生成的完整字体换成只包含界面用到的字符的子集(tools/font_subset.py)
+# ui_font_subset(<源文件列表变量> <bpp> <输出目录>)
+# 列表里的ui/fonts/ui_font_*.c换成生成的子集字体，构建时输出每个字体节省的flash和每帧从flash读取的字形数据量
+
+find_package(Python3 REQUIRED COMPONENTS Interpreter)
+
+set(UI_FONT_SUBSET_DIR ${CMAKE_CURRENT_LIST_DIR}/..)
+set(UI_FONT_SUBSET_TOOL ${CMAKE_CURRENT_LIST_DIR}/font_subset.py)
+
+# 扫描这些文件里显示到屏幕上的文字和数值格式
+set(UI_FONT_SUBSET_SCAN
+	${UI_FONT_SUBSET_DIR}/InfoLabel.cpp
+	${UI_FONT_SUBSET_DIR}/main.cpp
+	${UI_FONT_SUBSET_DIR}/ui/screens/ui_Screen1.c)
+
+# 每个字体一帧里画的文字：四个端口的读数，总电压和总功率
+set(UI_FONT_SAMPLES_ui_font_xlm_42 "0000mA 0000mW" "0000mA 0000mW" "0000mA 0000mW" "0000mA 0000mW")
+set(UI_FONT_SAMPLES_ui_font_lcd_mono_30 "00.000 V" "00.000 W")
+
+function(ui_font_subset src_var bpp out_dir)
+	set(srcs ${${src_var}})
+	set(fonts ${srcs})
+	list(FILTER fonts INCLUDE REGEX "/fonts/ui_font_[^/]*\\.c$")
+	list(FILTER srcs EXCLUDE REGEX "/fonts/ui_font_[^/]*\\.c$")
+
+	set(scan_args)
+	foreach(file ${UI_FONT_SUBSET_SCAN})
+		list(APPEND scan_args --scan ${file})
+	endforeach()
+
+	foreach(font_src ${fonts})
+		get_filename_component(font ${font_src} NAME_WE)
+		set(out ${out_dir}/${font}.c)
+		set(sample_args)
+		foreach(sample ${UI_FONT_SAMPLES_${font}})
+			list(APPEND sample_args --sample "${sample}")
+		endforeach()
+
+		add_custom_command(OUTPUT ${out}
+			COMMAND Python3::Interpreter ${UI_FONT_SUBSET_TOOL} ${font_src} -o ${out} --bpp ${bpp} ${scan_args} ${sample_args}
+			DEPENDS ${font_src} ${UI_FONT_SUBSET_TOOL} ${UI_FONT_SUBSET_SCAN}
+			COMMENT "Subsetting ${font} (${bpp} bpp)"
+			VERBATIM)
+		list(APPEND srcs ${out})
+	endforeach()
+
+	set(${src_var} ${srcs} PARENT_SCOPE)
+endfunction()
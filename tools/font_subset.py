@@ -0,0 +1,473 @@
+#!/usr/bin/env python3
+"""
+从lv_font_conv生成的完整字体(.c, --format lvgl --no-compress)里只保留界面用到的字符，
+可以同时把位图换成别的bpp，输出同样格式的.c，LVGL不需要任何修改
+
+用到的字符来自扫描源码里显示到屏幕上的文字：
+  - 含有set_text或者`<< "..."`/`<< std::`的行上的字符串字面量，以及这些行上引用的#define字符串
+  - printf风格的格式(%d %u %f ...)换成对应的数字、小数点和负号
+  - ostream的数值格式(setprecision/setw/fixed ...)换成数字和小数点
+再加上--chars指定的字符
+
+输出一行统计：字形数、bpp、字体数据占用的flash，以及按--sample给出的一帧文字完整重绘一次
+需要从flash(XIP)读取的字形数据量（字形描述 + 位图，不考虑SRAM里的字形缓存）
+
+用法:
+  font_subset.py ui/fonts/ui_font_xlm_42.c -o build/ui_font_xlm_42.c --bpp 4 \\
+      --scan InfoLabel.cpp --scan main.cpp --sample "0000mA 0000mW"
+"""
+
+import argparse
+import os
+import re
+import sys
+
+GLYPH_DSC_SIZE = 8          # sizeof(lv_font_fmt_txt_glyph_dsc_t)
+CMAP_SIZE = 20              # sizeof(lv_font_fmt_txt_cmap_t)，32位平台
+
+CMAP_FORMAT0_TINY = 'LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY'
+CMAP_FORMAT0_FULL = 'LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL'
+CMAP_SPARSE_TINY = 'LV_FONT_FMT_TXT_CMAP_SPARSE_TINY'
+CMAP_SPARSE_FULL = 'LV_FONT_FMT_TXT_CMAP_SPARSE_FULL'
+
+RE_STRING = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+RE_CHAR = re.compile(r"'((?:[^'\\\n]|\\.))'")
+RE_DEFINE = re.compile(r'^\s*#\s*define\s+(\w+)\s+"((?:[^"\\\n]|\\.)*)"', re.M)
+RE_PRINTF = re.compile(r'%[-+ #0]*(?:\d+|\*)?(?:\.(?:\d+|\*))?(?:hh|h|ll|l|z|j|t|L)?([diouxXfFeEgGcs%])')
+RE_GLYPH_DSC = re.compile(r'\{\.bitmap_index = (\d+), \.adv_w = (\d+), \.box_w = (\d+), \.box_h = (\d+), '
+                          r'\.ofs_x = (-?\d+), \.ofs_y = (-?\d+)\}')
+RE_CMAP = re.compile(r'\.range_start = (\d+), \.range_length = (\d+), \.glyph_id_start = (\d+),\s*'
+                     r'\.unicode_list = (\w+), \.glyph_id_ofs_list = (\w+), \.list_length = (\d+), \.type = (\w+)')
+
+DIGITS = '0123456789'
+
+
+class FontError(Exception):
+    pass
+
+
+def c_unescape(s):
+    """C字符串字面量里的转义，只处理常见的几种"""
+    out = []
+    i = 0
+    while i < len(s):
+        ch = s[i]
+        if ch != '\\' or i + 1 >= len(s):
+            out.append(ch)
+            i += 1
+            continue
+        nxt = s[i + 1]
+        simple = {'n': '\n', 't': '\t', 'r': '\r', '0': '\0', '\\': '\\', '"': '"', "'": "'"}
+        if nxt == 'x':
+            m = re.match(r'[0-9a-fA-F]+', s[i + 2:])
+            out.append(chr(int(m.group(0), 16)) if m else 'x')
+            i += 2 + (len(m.group(0)) if m else 0)
+            continue
+        out.append(simple.get(nxt, nxt))
+        i += 2
+    return ''.join(out)
+
+
+def printf_chars(fmt):
+    """去掉printf格式里的转换说明，返回(剩下的文字, 转换会产生的字符)"""
+    produced = set()
+    for m in RE_PRINTF.finditer(fmt):
+        conv = m.group(1)
+        if conv in 'diu':
+            produced.update(DIGITS)
+            if conv != 'u':
+                produced.add('-')
+        elif conv in 'fFeEgG':
+            produced.update(DIGITS + '.-')
+        elif conv in 'xX':
+            produced.update(DIGITS + ('abcdef' if conv == 'x' else 'ABCDEF'))
+        elif conv == 'o':
+            produced.update('01234567')
+        elif conv == '%':
+            produced.add('%')
+    return RE_PRINTF.sub('', fmt), produced
+
+
+def scan_source(path):
+    """源码里显示到屏幕上的字符"""
+    with open(path, encoding='utf-8') as f:
+        text = f.read()
+    defines = {m.group(1): c_unescape(m.group(2)) for m in RE_DEFINE.finditer(text)}
+    chars = set()
+
+    for line in text.splitlines():
+        code = line.split('//', 1)[0]
+        is_set_text = 'set_text' in code
+        is_stream = re.search(r'<<\s*("|std::)', code) is not None
+        if not is_set_text and not is_stream:
+            continue
+
+        literals = [c_unescape(s) for s in RE_STRING.findall(code)]
+        literals += [defines[name] for name in re.findall(r'\b[A-Za-z_]\w*\b', code) if name in defines]
+        for lit in literals:
+            rest, produced = printf_chars(lit) if is_set_text else (lit, set())
+            chars.update(rest)
+            chars.update(produced)
+
+        if is_stream:
+            chars.update(c_unescape(c) for c in RE_CHAR.findall(code))
+            if re.search(r'\b(setw|setprecision|fixed|dec)\b', code):
+                chars.update(DIGITS)
+            if re.search(r'\b(setprecision|fixed)\b', code):
+                chars.add('.')
+
+    return {c for c in chars if c >= ' '}
+
+
+def c_array(text, name):
+    """static const <type> name[] = {...}; 里的整数"""
+    m = re.search(r'\b' + re.escape(name) + r'\[\]\s*=\s*\{(.*?)\};', text, re.S)
+    if m is None:
+        raise FontError('array %s not found' % name)
+    body = re.sub(r'/\*.*?\*/', '', m.group(1), flags=re.S)
+    return [int(v, 0) for v in re.findall(r'0x[0-9a-fA-F]+|\d+', body)]
+
+
+def c_field(text, name, default=None):
+    m = re.search(r'\.' + name + r'\s*=\s*(-?\w+)', text)
+    if m is None:
+        if default is None:
+            raise FontError('field .%s not found' % name)
+        return default
+    return m.group(1)
+
+
+class Font:
+    def __init__(self, path):
+        with open(path, encoding='utf-8') as f:
+            text = f.read()
+        self.path = path
+
+        m = re.search(r'const lv_font_t (\w+) = \{(.*?)\};', text, re.S)
+        if m is None:
+            raise FontError('%s: no lv_font_t' % path)
+        self.name = m.group(1)
+        public = m.group(2)
+        m = re.search(r'static const lv_font_fmt_txt_dsc_t font_dsc = \{(.*?)\};', text, re.S)
+        if m is None:
+            raise FontError('%s: no font_dsc' % path)
+        dsc = m.group(1)
+
+        if c_field(dsc, 'kern_dsc') != 'NULL':
+            raise FontError('%s: kerning is not supported' % path)
+        if int(c_field(dsc, 'bitmap_format')) != 0:
+            raise FontError('%s: compressed fonts are not supported, regenerate with --no-compress' % path)
+        self.bpp = int(c_field(dsc, 'bpp'))
+        self.line_height = int(c_field(public, 'line_height'))
+        self.base_line = int(c_field(public, 'base_line'))
+        self.underline_position = int(c_field(public, 'underline_position', '0'))
+        self.underline_thickness = int(c_field(public, 'underline_thickness', '0'))
+
+        m = re.search(r'\* Size: (\d+) px', text)
+        self.size = int(m.group(1)) if m else 0
+        m = re.search(r'#ifndef (\w+)\n#define \1 1', text)
+        self.guard = m.group(1) if m else self.name.upper()
+
+        self.bitmap = bytes(c_array(text, 'glyph_bitmap'))
+        m = re.search(r'glyph_dsc\[\]\s*=\s*\{(.*?)\n\};', text, re.S)
+        self.glyphs = [tuple(int(v) for v in g) for g in RE_GLYPH_DSC.findall(m.group(1))]
+
+        # 码点 -> 字形id
+        self.cmap = {}
+        self.cmap_bytes = 0
+        for start, length, gid_start, ulist, olist, list_len, kind in RE_CMAP.findall(text):
+            start, length, gid_start, list_len = int(start), int(length), int(gid_start), int(list_len)
+            unicode_list = c_array(text, ulist) if ulist != 'NULL' else None
+            ofs_list = c_array(text, olist) if olist != 'NULL' else None
+            self.cmap_bytes += CMAP_SIZE + (2 * list_len if unicode_list else 0)
+            if ofs_list:
+                self.cmap_bytes += list_len * (2 if kind == CMAP_SPARSE_FULL else 1)
+
+            if kind == CMAP_FORMAT0_TINY:
+                for i in range(length):
+                    self.cmap[start + i] = gid_start + i
+            elif kind == CMAP_FORMAT0_FULL:
+                for i, ofs in enumerate(ofs_list):
+                    # 范围内缺少的字符偏移为0，和范围的第一个字符区分不开，当作没有
+                    if ofs or i == 0:
+                        self.cmap[start + i] = gid_start + ofs
+            elif kind == CMAP_SPARSE_TINY:
+                for i, u in enumerate(unicode_list):
+                    self.cmap[start + u] = gid_start + i
+            elif kind == CMAP_SPARSE_FULL:
+                for i, u in enumerate(unicode_list):
+                    self.cmap[start + u] = gid_start + ofs_list[i]
+            else:
+                raise FontError('%s: unknown cmap type %s' % (path, kind))
+
+    def bitmap_size(self, gid, bpp=None):
+        _, _, box_w, box_h, _, _ = self.glyphs[gid]
+        return (box_w * box_h * (bpp or self.bpp) + 7) // 8
+
+    def pixels(self, gid):
+        """字形的所有像素，按行连续，每个像素一个0..(2^bpp-1)的值"""
+        index, _, box_w, box_h, _, _ = self.glyphs[gid]
+        data = self.bitmap[index:index + self.bitmap_size(gid)]
+        px_max = (1 << self.bpp) - 1
+        out = []
+        for i in range(box_w * box_h):
+            bit = i * self.bpp
+            out.append((data[bit >> 3] >> (8 - self.bpp - (bit & 7))) & px_max)
+        return out
+
+    def flash_bytes(self):
+        return len(self.bitmap) + GLYPH_DSC_SIZE * len(self.glyphs) + self.cmap_bytes
+
+
+def requantize(px, src_bpp, dst_bpp):
+    if src_bpp == dst_bpp:
+        return px
+    src_max = (1 << src_bpp) - 1
+    dst_max = (1 << dst_bpp) - 1
+    return [(v * dst_max * 2 + src_max) // (src_max * 2) for v in px]
+
+
+def pack(px, bpp):
+    """按LVGL的格式打包：高位在前，一个字形的像素连续存放，字形从整字节开始"""
+    out = bytearray((len(px) * bpp + 7) // 8)
+    for i, v in enumerate(px):
+        bit = i * bpp
+        out[bit >> 3] |= v << (8 - bpp - (bit & 7))
+    return bytes(out)
+
+
+def char_comment(cp):
+    ch = chr(cp)
+    if ch in '"\\':
+        ch = '\\' + ch
+    return '/* U+%04X "%s" */' % (cp, ch)
+
+
+def hex_lines(values, per_line, fmt='0x%x'):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join(fmt % v for v in values[i:i + per_line]))
+    return ',\n'.join(lines)
+
+
+def write_subset(font, codepoints, bpp, out_path, opts):
+    """输出和lv_font_conv相同结构的.c，字形按码点排序，id从1开始"""
+    bitmap_chunks = []
+    glyph_lines = ['    {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */']
+    bitmap_len = 0
+    for cp in codepoints:
+        gid = font.cmap[cp]
+        _, adv_w, box_w, box_h, ofs_x, ofs_y = font.glyphs[gid]
+        data = pack(requantize(font.pixels(gid), font.bpp, bpp), bpp)
+        chunk = '    ' + char_comment(cp) + '\n'
+        if data:
+            chunk += hex_lines(list(data), 8) + ',\n'
+        bitmap_chunks.append(chunk)
+        glyph_lines.append('    {.bitmap_index = %d, .adv_w = %d, .box_w = %d, .box_h = %d, .ofs_x = %d, .ofs_y = %d}'
+                           % (bitmap_len, adv_w, box_w, box_h, ofs_x, ofs_y))
+        bitmap_len += len(data)
+
+    bitmap_body = '\n'.join(bitmap_chunks).rstrip(',\n')
+    if not bitmap_body.strip():
+        bitmap_body = '    0x0'
+
+    start = codepoints[0]
+    length = codepoints[-1] - start + 1
+    if length == len(codepoints):
+        unicode_decl = ''
+        cmap = ('        .range_start = %d, .range_length = %d, .glyph_id_start = 1,\n'
+                '        .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, .type = %s'
+                % (start, length, CMAP_FORMAT0_TINY))
+    else:
+        unicode_decl = ('static const uint16_t unicode_list_0[] = {\n%s\n};\n\n'
+                        % hex_lines([cp - start for cp in codepoints], 8))
+        cmap = ('        .range_start = %d, .range_length = %d, .glyph_id_start = 1,\n'
+                '        .unicode_list = unicode_list_0, .glyph_id_ofs_list = NULL, .list_length = %d, .type = %s'
+                % (start, length, len(codepoints), CMAP_SPARSE_TINY))
+
+    text = TEMPLATE.format(
+        size=font.size, bpp=bpp, opts=opts, guard=font.guard, name=font.name,
+        bitmap=bitmap_body, glyph_dsc=',\n'.join(glyph_lines), unicode_decl=unicode_decl, cmap=cmap,
+        line_height=font.line_height, base_line=font.base_line,
+        underline_position=font.underline_position, underline_thickness=font.underline_thickness)
+
+    out_dir = os.path.dirname(out_path)
+    if out_dir:
+        os.makedirs(out_dir, exist_ok=True)
+    with open(out_path, 'w', encoding='utf-8', newline='\n') as f:
+        f.write(text)
+
+    cmap_bytes = CMAP_SIZE + (0 if length == len(codepoints) else 2 * len(codepoints))
+    return bitmap_len + GLYPH_DSC_SIZE * (len(codepoints) + 1) + cmap_bytes
+
+
+def frame_xip_bytes(font, samples, bpp):
+    """按samples完整重绘一次需要从flash读取的字形描述和位图字节数，空格没有位图"""
+    total = 0
+    for text in samples:
+        for ch in text:
+            gid = font.cmap.get(ord(ch))
+            if gid is None:
+                continue
+            total += GLYPH_DSC_SIZE + font.bitmap_size(gid, bpp)
+    return total
+
+
+TEMPLATE = '''\
+/*******************************************************************************
+ * Size: {size} px
+ * Bpp: {bpp}
+ * Opts: {opts}
+ * Generated by tools/font_subset.py, do not edit
+ ******************************************************************************/
+
+#include "ui.h"
+
+#ifndef {guard}
+#define {guard} 1
+#endif
+
+#if {guard}
+
+/*-----------------
+ *    BITMAPS
+ *----------------*/
+
+/*Store the image of the glyphs*/
+static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {{
+{bitmap}
+}};
+
+
+/*---------------------
+ *  GLYPH DESCRIPTION
+ *--------------------*/
+
+static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {{
+{glyph_dsc}
+}};
+
+/*---------------------
+ *  CHARACTER MAPPING
+ *--------------------*/
+
+{unicode_decl}/*Collect the unicode lists and glyph_id offsets*/
+static const lv_font_fmt_txt_cmap_t cmaps[] =
+{{
+    {{
+{cmap}
+    }}
+}};
+
+
+
+/*--------------------
+ *  ALL CUSTOM DATA
+ *--------------------*/
+
+#if LVGL_VERSION_MAJOR == 8
+/*Store all the custom data of the font*/
+static  lv_font_fmt_txt_glyph_cache_t cache;
+#endif
+
+#if LVGL_VERSION_MAJOR >= 8
+static const lv_font_fmt_txt_dsc_t font_dsc = {{
+#else
+static lv_font_fmt_txt_dsc_t font_dsc = {{
+#endif
+    .glyph_bitmap = glyph_bitmap,
+    .glyph_dsc = glyph_dsc,
+    .cmaps = cmaps,
+    .kern_dsc = NULL,
+    .kern_scale = 0,
+    .cmap_num = 1,
+    .bpp = {bpp},
+    .kern_classes = 0,
+    .bitmap_format = 0,
+#if LVGL_VERSION_MAJOR == 8
+    .cache = &cache
+#endif
+}};
+
+
+
+/*-----------------
+ *  PUBLIC FONT
+ *----------------*/
+
+/*Initialize a public general font descriptor*/
+#if LVGL_VERSION_MAJOR >= 8
+const lv_font_t {name} = {{
+#else
+lv_font_t {name} = {{
+#endif
+    .get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,    /*Function pointer to get glyph's data*/
+    .get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,    /*Function pointer to get glyph's bitmap*/
+    .line_height = {line_height},          /*The maximum line height required by the font*/
+    .base_line = {base_line},             /*Baseline measured from the bottom of the line*/
+#if !(LVGL_VERSION_MAJOR == 6 && LVGL_VERSION_MINOR == 0)
+    .subpx = LV_FONT_SUBPX_NONE,
+#endif
+#if LV_VERSION_CHECK(7, 4, 0) || LVGL_VERSION_MAJOR >= 8
+    .underline_position = {underline_position},
+    .underline_thickness = {underline_thickness},
+#endif
+    .dsc = &font_dsc,          /*The custom font data. Will be accessed by `get_glyph_bitmap/dsc` */
+#if LV_VERSION_CHECK(8, 2, 0) || LVGL_VERSION_MAJOR >= 9
+    .fallback = NULL,
+#endif
+    .user_data = NULL,
+}};
+
+
+
+#endif /*#if {guard}*/
+'''
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Subset an lv_font_conv C font to the characters the UI displays')
+    parser.add_argument('font', help='full font generated by lv_font_conv (--format lvgl --no-compress)')
+    parser.add_argument('-o', '--output', required=True, help='subsetted font to write')
+    parser.add_argument('--bpp', type=int, choices=(1, 2, 4, 8), help='bpp of the output, default: same as the input')
+    parser.add_argument('--scan', action='append', default=[], help='source file with the displayed text formats')
+    parser.add_argument('--chars', default='', help='extra characters to keep')
+    parser.add_argument('--sample', action='append', default=[],
+                        help='text drawn with this font in one frame, for the XIP estimate (repeatable)')
+    args = parser.parse_args()
+
+    try:
+        font = Font(args.font)
+    except (OSError, FontError) as e:
+        print('font_subset: %s' % e, file=sys.stderr)
+        return 1
+    bpp = args.bpp or font.bpp
+
+    chars = set(args.chars)
+    for path in args.scan:
+        chars |= scan_source(path)
+    missing = sorted(c for c in chars if ord(c) not in font.cmap)
+    codepoints = sorted(ord(c) for c in chars if ord(c) in font.cmap)
+    if missing:
+        print('font_subset: %s has no glyph for %s, skipped' % (font.name, ''.join(missing)), file=sys.stderr)
+    if not codepoints:
+        print('font_subset: no characters to keep', file=sys.stderr)
+        return 1
+
+    kept = ''.join(chr(cp) for cp in codepoints)
+    opts = 'subset of %s, bpp %d, chars "%s"' % (os.path.basename(args.font), bpp,
+                                                  kept.replace('\\', '\\\\').replace('"', '\\"'))
+    flash = write_subset(font, codepoints, bpp, args.output, opts)
+
+    samples = args.sample or [kept]
+    xip_before = frame_xip_bytes(font, samples, font.bpp)
+    xip_after = frame_xip_bytes(font, samples, bpp)
+    print('font_subset: %s: %d -> %d glyphs, bpp %d -> %d, flash %d -> %d B (saved %d B), '
+          'XIP per full redraw %d -> %d B'
+          % (font.name, len(font.glyphs) - 1, len(codepoints), font.bpp, bpp, font.flash_bytes(), flash,
+             font.flash_bytes() - flash, xip_before, xip_after))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
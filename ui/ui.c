@@ -5,6 +5,8 @@
 
 #include "ui.h"
 #include "ui_helpers.h"
+#include "ui_anim_slab.h"
+#include "ui_hw_slide.h"
 
 ///////////////////// VARIABLES ////////////////////
 lv_anim_t * plenable_Animation(lv_obj_t * TargetObject, int delay);
@@ -29,9 +31,9 @@ lv_obj_t * ui____initial_actions0;
 lv_anim_t * plenable_Animation(lv_obj_t * TargetObject, int delay)
 {
     lv_anim_t * out_anim;
-    ui_anim_user_data_t * PropertyAnimation_0_user_data = lv_mem_alloc(sizeof(ui_anim_user_data_t));
-    PropertyAnimation_0_user_data->target = TargetObject;
-    PropertyAnimation_0_user_data->val = -1;
+    ui_anim_user_data_t * PropertyAnimation_user_data[UI_ANIM_SLAB_SLOT_ANIMS];
+    ui_anim_slab_alloc(TargetObject, PropertyAnimation_user_data, 2);
+    ui_anim_user_data_t * PropertyAnimation_0_user_data = PropertyAnimation_user_data[0];
     lv_anim_t PropertyAnimation_0;
     lv_anim_init(&PropertyAnimation_0);
     lv_anim_set_time(&PropertyAnimation_0, 500);
@@ -47,9 +49,7 @@ lv_anim_t * plenable_Animation(lv_obj_t * TargetObject, int delay)
     lv_anim_set_repeat_delay(&PropertyAnimation_0, 0);
     lv_anim_set_early_apply(&PropertyAnimation_0, false);
     out_anim = lv_anim_start(&PropertyAnimation_0);
-    ui_anim_user_data_t * PropertyAnimation_1_user_data = lv_mem_alloc(sizeof(ui_anim_user_data_t));
-    PropertyAnimation_1_user_data->target = TargetObject;
-    PropertyAnimation_1_user_data->val = -1;
+    ui_anim_user_data_t * PropertyAnimation_1_user_data = PropertyAnimation_user_data[1];
     lv_anim_t PropertyAnimation_1;
     lv_anim_init(&PropertyAnimation_1);
     lv_anim_set_time(&PropertyAnimation_1, 500);
@@ -71,9 +71,9 @@ lv_anim_t * plenable_Animation(lv_obj_t * TargetObject, int delay)
 lv_anim_t * plfromleft_Animation(lv_obj_t * TargetObject, int delay)
 {
     lv_anim_t * out_anim;
-    ui_anim_user_data_t * PropertyAnimation_0_user_data = lv_mem_alloc(sizeof(ui_anim_user_data_t));
-    PropertyAnimation_0_user_data->target = TargetObject;
-    PropertyAnimation_0_user_data->val = -1;
+    ui_anim_user_data_t * PropertyAnimation_user_data[UI_ANIM_SLAB_SLOT_ANIMS];
+    ui_anim_slab_alloc(TargetObject, PropertyAnimation_user_data, 2);
+    ui_anim_user_data_t * PropertyAnimation_0_user_data = PropertyAnimation_user_data[0];
     lv_anim_t PropertyAnimation_0;
     lv_anim_init(&PropertyAnimation_0);
     lv_anim_set_time(&PropertyAnimation_0, 500);
@@ -90,9 +90,7 @@ lv_anim_t * plfromleft_Animation(lv_obj_t * TargetObject, int delay)
     lv_anim_set_early_apply(&PropertyAnimation_0, false);
     lv_anim_set_get_value_cb(&PropertyAnimation_0, &_ui_anim_callback_get_x);
     out_anim = lv_anim_start(&PropertyAnimation_0);
-    ui_anim_user_data_t * PropertyAnimation_1_user_data = lv_mem_alloc(sizeof(ui_anim_user_data_t));
-    PropertyAnimation_1_user_data->target = TargetObject;
-    PropertyAnimation_1_user_data->val = -1;
+    ui_anim_user_data_t * PropertyAnimation_1_user_data = PropertyAnimation_user_data[1];
     lv_anim_t PropertyAnimation_1;
     lv_anim_init(&PropertyAnimation_1);
     lv_anim_set_time(&PropertyAnimation_1, 250);
@@ -115,9 +113,9 @@ lv_anim_t * plfromleft_Animation(lv_obj_t * TargetObject, int delay)
 lv_anim_t * pldisable_Animation(lv_obj_t * TargetObject, int delay)
 {
     lv_anim_t * out_anim;
-    ui_anim_user_data_t * PropertyAnimation_0_user_data = lv_mem_alloc(sizeof(ui_anim_user_data_t));
-    PropertyAnimation_0_user_data->target = TargetObject;
-    PropertyAnimation_0_user_data->val = -1;
+    ui_anim_user_data_t * PropertyAnimation_user_data[UI_ANIM_SLAB_SLOT_ANIMS];
+    ui_anim_slab_alloc(TargetObject, PropertyAnimation_user_data, 2);
+    ui_anim_user_data_t * PropertyAnimation_0_user_data = PropertyAnimation_user_data[0];
     lv_anim_t PropertyAnimation_0;
     lv_anim_init(&PropertyAnimation_0);
     lv_anim_set_time(&PropertyAnimation_0, 500);
@@ -133,9 +131,7 @@ lv_anim_t * pldisable_Animation(lv_obj_t * TargetObject, int delay)
     lv_anim_set_repeat_delay(&PropertyAnimation_0, 0);
     lv_anim_set_early_apply(&PropertyAnimation_0, false);
     out_anim = lv_anim_start(&PropertyAnimation_0);
-    ui_anim_user_data_t * PropertyAnimation_1_user_data = lv_mem_alloc(sizeof(ui_anim_user_data_t));
-    PropertyAnimation_1_user_data->target = TargetObject;
-    PropertyAnimation_1_user_data->val = -1;
+    ui_anim_user_data_t * PropertyAnimation_1_user_data = PropertyAnimation_user_data[1];
     lv_anim_t PropertyAnimation_1;
     lv_anim_init(&PropertyAnimation_1);
     lv_anim_set_time(&PropertyAnimation_1, 500);
@@ -162,6 +158,10 @@ void ui_event____initial_actions0(lv_event_t * e)
     lv_event_code_t event_code = lv_event_get_code(e);
 
     if(event_code == LV_EVENT_SCREEN_LOAD_START) {
+#if UI_BOOT_HW_SLIDE
+        /*The panels are already at their final position, push the whole screen in at once*/
+        if(ui_hw_slide_in(0, lv_disp_get_hor_res(NULL) - 1, 500)) return;
+#endif
         plenable_Animation(ui_pl_port1, 0);
         plenable_Animation(ui_pl_port2, 50);
         plenable_Animation(ui_pl_port3, 100);
@@ -0,0 +1,82 @@
+// Fixed-capacity storage for the user data of the SquareLine property animations.
+// Not generated by SquareLine Studio: keep this file when re-exporting the project.
+
+#include "ui_anim_slab.h"
+
+typedef struct {
+    ui_anim_user_data_t user_data[UI_ANIM_SLAB_SLOT_ANIMS];
+    uint8_t refs;
+} ui_anim_slab_slot_t;
+
+static ui_anim_slab_slot_t slab[UI_ANIM_SLAB_SLOTS];
+static ui_anim_slab_stats_t slab_stats;
+
+static ui_anim_slab_slot_t * slot_of(const ui_anim_user_data_t * user_data)
+{
+    const uint8_t * p = (const uint8_t *)user_data;
+    const uint8_t * begin = (const uint8_t *)&slab[0];
+    const uint8_t * end = (const uint8_t *)&slab[UI_ANIM_SLAB_SLOTS];
+    if(p < begin || p >= end) return NULL;
+
+    return &slab[(p - begin) / sizeof(ui_anim_slab_slot_t)];
+}
+
+static void init_user_data(ui_anim_user_data_t * user_data, lv_obj_t * target)
+{
+    lv_memset_00(user_data, sizeof(ui_anim_user_data_t));
+    user_data->target = target;
+    user_data->val = -1;
+}
+
+void ui_anim_slab_alloc(lv_obj_t * target, ui_anim_user_data_t ** out, uint8_t cnt)
+{
+    ui_anim_slab_slot_t * slot = NULL;
+    if(cnt <= UI_ANIM_SLAB_SLOT_ANIMS) {
+        for(uint16_t i = 0; i < UI_ANIM_SLAB_SLOTS; i++) {
+            if(slab[i].refs == 0) {
+                slot = &slab[i];
+                break;
+            }
+        }
+    }
+
+    if(slot) {
+        slot->refs = cnt;
+        for(uint8_t i = 0; i < cnt; i++) {
+            init_user_data(&slot->user_data[i], target);
+            out[i] = &slot->user_data[i];
+        }
+        slab_stats.slab_allocs++;
+        slab_stats.slots_used++;
+        if(slab_stats.slots_used > slab_stats.slots_peak) slab_stats.slots_peak = slab_stats.slots_used;
+        return;
+    }
+
+    /*Out of slots: behave like the generated code did*/
+    for(uint8_t i = 0; i < cnt; i++) {
+        out[i] = lv_mem_alloc(sizeof(ui_anim_user_data_t));
+        LV_ASSERT_MALLOC(out[i]);
+        init_user_data(out[i], target);
+        slab_stats.heap_allocs++;
+    }
+}
+
+void ui_anim_slab_free(ui_anim_user_data_t * user_data)
+{
+    if(user_data == NULL) return;
+
+    ui_anim_slab_slot_t * slot = slot_of(user_data);
+    if(slot == NULL) {
+        lv_mem_free(user_data);
+        return;
+    }
+
+    if(slot->refs == 0) return;
+    slot->refs--;
+    if(slot->refs == 0) slab_stats.slots_used--;
+}
+
+void ui_anim_slab_get_stats(ui_anim_slab_stats_t * stats)
+{
+    *stats = slab_stats;
+}
@@ -0,0 +1,44 @@
+// Fixed-capacity storage for the user data of the SquareLine property animations.
+// Not generated by SquareLine Studio: keep this file when re-exporting the project.
+// The lv_anim_t copies made by lv_anim_start come from LVGL's own pool (LV_ANIM_POOL_SIZE in lv_conf.h).
+
+#ifndef _CH335F_USB_HUB_UI_ANIM_SLAB_H
+#define _CH335F_USB_HUB_UI_ANIM_SLAB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ui_helpers.h"
+
+/* Every animation helper in ui.c starts two property animations on the same target */
+#define UI_ANIM_SLAB_SLOT_ANIMS 2
+/* 4 port panels + the voltage panel, with room for an enable and a disable transition each */
+#define UI_ANIM_SLAB_SLOTS 10
+
+typedef struct _ui_anim_slab_stats_t {
+    uint32_t slab_allocs;       /**< Transitions served from the slab*/
+    uint32_t heap_allocs;       /**< `lv_mem_alloc` calls made because the slab was full*/
+    uint16_t slots_used;        /**< Slots currently holding a running transition*/
+    uint16_t slots_peak;        /**< Highest `slots_used` seen so far*/
+} ui_anim_slab_stats_t;
+
+/**
+ * Get `cnt` user data blocks for the animations of one transition.
+ * The blocks share one slab slot; when no slot is free each block is allocated with `lv_mem_alloc` instead.
+ * `target` is set and `val` is reset to -1 in every block.
+ */
+void ui_anim_slab_alloc(lv_obj_t * target, ui_anim_user_data_t ** out, uint8_t cnt);
+
+/**
+ * Release one block obtained with `ui_anim_slab_alloc`. The slot is reused once all its blocks are released.
+ */
+void ui_anim_slab_free(ui_anim_user_data_t * user_data);
+
+void ui_anim_slab_get_stats(ui_anim_slab_stats_t * stats);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif
@@ -4,6 +4,7 @@
 // Project name: CH335F_USB_HUB
 
 #include "ui_helpers.h"
+#include "ui_anim_slab.h"
 
 void _ui_bar_set_property(lv_obj_t * target, int id, int val)
 {
@@ -137,7 +138,7 @@ void _ui_opacity_set(lv_obj_t * target, int val)
 
 void _ui_anim_callback_free_user_data(lv_anim_t * a)
 {
-    lv_mem_free(a->user_data);
+    ui_anim_slab_free(a->user_data);
     a->user_data = NULL;
 }
 
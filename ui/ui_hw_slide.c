@@ -0,0 +1,39 @@
+// Slide transitions driven by the display's hardware scrolling.
+// Not generated by SquareLine Studio: keep this file when re-exporting the project.
+
+#include "ui_hw_slide.h"
+
+static ui_hw_slide_begin_cb_t port_begin_cb;
+static ui_hw_slide_set_cb_t port_set_cb;
+
+static void slide_exec_cb(void * var, int32_t v)
+{
+    LV_UNUSED(var);
+    port_set_cb((lv_coord_t)v);
+}
+
+void ui_hw_slide_set_port(ui_hw_slide_begin_cb_t begin_cb, ui_hw_slide_set_cb_t set_cb)
+{
+    port_begin_cb = begin_cb;
+    port_set_cb = set_cb;
+}
+
+bool ui_hw_slide_in(lv_coord_t x1, lv_coord_t x2, uint32_t time)
+{
+    if(port_begin_cb == NULL || port_set_cb == NULL) return false;
+    if(!port_begin_cb(x1, x2)) return false;
+
+    /*The scroll area is clamped to the screen by the port, animate over the same width*/
+    x1 = LV_MAX(x1, 0);
+    x2 = LV_MIN(x2, lv_disp_get_hor_res(NULL) - 1);
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_exec_cb(&a, slide_exec_cb);
+    lv_anim_set_values(&a, 0, x2 - x1 + 1);
+    lv_anim_set_time(&a, time);
+    lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+    lv_anim_set_early_apply(&a, false);
+    lv_anim_start(&a);
+    return true;
+}
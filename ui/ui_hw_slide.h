@@ -0,0 +1,41 @@
+// Slide transitions driven by the display's hardware scrolling.
+// Not generated by SquareLine Studio: keep this file when re-exporting the project.
+
+#ifndef _CH335F_USB_HUB_UI_HW_SLIDE_H
+#define _CH335F_USB_HUB_UI_HW_SLIDE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl.h"
+
+/* 1: on screen load the whole screen is pushed in from the right by hardware scrolling
+ * instead of the per-panel plenable/plfromleft animations */
+#ifndef UI_BOOT_HW_SLIDE
+#define UI_BOOT_HW_SLIDE 0
+#endif
+
+/* Display port functions doing the scrolling (disp_slide_begin/disp_slide_set of lv_port_disp) */
+typedef bool (*ui_hw_slide_begin_cb_t)(lv_coord_t x1, lv_coord_t x2);
+typedef void (*ui_hw_slide_set_cb_t)(lv_coord_t revealed);
+
+/**
+ * Set the display port functions used by ui_hw_slide_in, the ui doesn't depend on the display port itself.
+ * Call it before ui_init(); NULL disables the hardware slide.
+ */
+void ui_hw_slide_set_port(ui_hw_slide_begin_cb_t begin_cb, ui_hw_slide_set_cb_t set_cb);
+
+/**
+ * Push the content of the columns [x1, x2] in from the right, the old content leaves to the left.
+ * The objects have to be at their final position already: LVGL renders and sends only the newly exposed strip
+ * every frame, the display's vertical scroll registers move the rest.
+ * Returns false when no display port is set or it can't scroll (nothing changes on the screen then).
+ */
+bool ui_hw_slide_in(lv_coord_t x1, lv_coord_t x2, uint32_t time);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif
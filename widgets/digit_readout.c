@@ -0,0 +1,432 @@
+/**
+ * @file digit_readout.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "digit_readout.h"
+#if DIGIT_READOUT_USE_ATLAS
+#include "src/draw/sw/lv_draw_sw.h"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define MY_CLASS &digit_readout_class
+
+#define ATLAS_GLYPHS	(10)		//贴图只包含'0'~'9'
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+#if DIGIT_READOUT_USE_ATLAS
+typedef struct {
+	lv_coord_t ofs_x;				//字形框相对字符格左上角的位置，和lv_draw_sw_letter的算法一致
+	lv_coord_t ofs_y;
+	lv_coord_t w;
+	lv_coord_t h;
+	const lv_color_t *px;			//w*h个已经混合好的像素，NULL表示字体里没有这个字形
+} atlas_glyph_t;
+
+typedef struct {
+	const lv_font_t *font;
+	lv_color_t fg;
+	lv_color_t bg;
+	atlas_glyph_t glyphs[ATLAS_GLYPHS];
+	lv_color_t *buf;				//所有字形的像素放在一块内存里
+} atlas_slot_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void digit_readout_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj);
+static void digit_readout_event(const lv_obj_class_t *class_p, lv_event_t *e);
+static void refresh_cell_width(lv_obj_t *obj);
+static void invalidate_cell(lv_obj_t *obj, uint8_t idx);
+static void draw_cells(lv_event_t *e);
+#if DIGIT_READOUT_USE_ATLAS
+static bool atlas_glyph_dsc(const lv_font_t *font, char ch, lv_font_glyph_dsc_t *g);
+static void atlas_blend(lv_color_t *dest, const uint8_t *map, const lv_font_glyph_dsc_t *g, lv_color_t fg,
+						lv_color_t bg);
+static bool atlas_draw(lv_draw_ctx_t *draw_ctx, const lv_draw_label_dsc_t *dsc, const lv_point_t *pos, char ch);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+const lv_obj_class_t digit_readout_class = {
+	.base_class = &lv_obj_class,
+	.constructor_cb = digit_readout_constructor,
+	.event_cb = digit_readout_event,
+	.width_def = LV_SIZE_CONTENT,
+	.height_def = LV_SIZE_CONTENT,
+	.instance_size = sizeof(digit_readout_t),
+};
+
+#if DIGIT_READOUT_USE_ATLAS
+static atlas_slot_t atlas[DIGIT_READOUT_ATLAS_SLOTS];
+static uint8_t atlas_cnt;
+static digit_readout_atlas_stats_t atlas_stats;
+#endif
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * @brief 创建一个数字读数控件，字体取自控件的text_font样式
+ * @param parent 父对象
+ * @return 创建的控件
+ */
+lv_obj_t *digit_readout_create(lv_obj_t *parent) {
+	lv_obj_t *obj = lv_obj_class_create_obj(MY_CLASS, parent);
+	lv_obj_class_init_obj(obj);
+	return obj;
+}
+
+/**
+ * @brief 从start格开始写入一段字符，所有字符使用同一颜色，必要时增加格数
+ * 超出DIGIT_READOUT_MAX_CELLS的字符被忽略
+ * @param obj 数字读数控件
+ * @param start 起始格
+ * @param txt 要写入的字符（仅支持单字节字符）
+ * @param color 字符颜色
+ */
+void digit_readout_set_text(lv_obj_t *obj, uint8_t start, const char *txt, lv_color_t color) {
+	digit_readout_t *readout = (digit_readout_t *)obj;
+	if (start >= DIGIT_READOUT_MAX_CELLS) return;
+
+	uint8_t end = start;
+	for (const char *p = txt; *p != '\0' && end < DIGIT_READOUT_MAX_CELLS; p++) end++;
+
+	//格数增加时新格先记为空格，随后由set_cell决定是否需要重绘
+	if (end > readout->cell_cnt) {
+		for (uint8_t i = readout->cell_cnt; i < end; i++) {
+			readout->cells[i] = ' ';
+			readout->colors[i] = color;
+		}
+		readout->cell_cnt = end;
+		lv_obj_refresh_self_size(obj);
+	}
+
+	for (uint8_t i = start; i < end; i++) {
+		digit_readout_set_cell(obj, i, txt[i - start], color);
+	}
+}
+
+/**
+ * @brief 设置一格的字符和颜色，只有内容真的变化时才重绘该格
+ * @param obj 数字读数控件
+ * @param idx 格的序号
+ * @param ch 字符
+ * @param color 颜色
+ */
+void digit_readout_set_cell(lv_obj_t *obj, uint8_t idx, char ch, lv_color_t color) {
+	digit_readout_t *readout = (digit_readout_t *)obj;
+	if (idx >= readout->cell_cnt) return;
+
+	if (readout->cells[idx] == ch && readout->colors[idx].full == color.full) return;
+
+	readout->cells[idx] = ch;
+	readout->colors[idx] = color;
+	invalidate_cell(obj, idx);
+}
+
+/**
+ * @brief 以固定位数、补前导0的方式写入一个十进制整数，前导0使用lead_color
+ * @param obj 数字读数控件
+ * @param start 起始格
+ * @param width 位数，超出范围的数值显示为全9
+ * @param value 数值
+ * @param color 有效数字颜色
+ * @param lead_color 前导0颜色
+ */
+void digit_readout_set_number(lv_obj_t *obj, uint8_t start, uint8_t width, uint32_t value,
+							  lv_color_t color, lv_color_t lead_color) {
+	uint32_t max = 1;
+	for (uint8_t i = 0; i < width; i++) max *= 10;
+	if (value >= max) value = max - 1;
+
+	//从最低位往高位写，第一位（个位）总是有效数字
+	bool leading = false;
+	for (int i = width - 1; i >= 0; i--) {
+		digit_readout_set_cell(obj, start + i, (char)('0' + value % 10), leading ? lead_color : color);
+		value /= 10;
+		if (value == 0) leading = true;
+	}
+}
+
+/**
+ * @brief 获取格数
+ */
+uint8_t digit_readout_get_cell_count(const lv_obj_t *obj) {
+	return ((const digit_readout_t *)obj)->cell_cnt;
+}
+
+/**
+ * @brief 获取某一格在屏幕上的区域（绝对坐标）
+ * @param obj 数字读数控件
+ * @param idx 格的序号
+ * @param area 存放结果
+ */
+void digit_readout_get_cell_area(const lv_obj_t *obj, uint8_t idx, lv_area_t *area) {
+	const digit_readout_t *readout = (const digit_readout_t *)obj;
+	const lv_font_t *font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+
+	lv_obj_get_content_coords(obj, area);
+	area->x1 += idx * readout->cell_w;
+	area->x2 = area->x1 + readout->cell_w - 1;
+	area->y2 = area->y1 + lv_font_get_line_height(font) - 1;
+}
+
+#if DIGIT_READOUT_USE_ATLAS
+/**
+ * @brief 登记一组颜色，生成'0'~'9'和背景混合后的贴图，同样的组合重复登记直接返回true
+ * 混合公式和lv_draw_sw_blend的带遮罩填充相同，拷贝贴图和逐像素混合的结果完全一致
+ * @param font 字体，只支持不使用fallback、非子像素渲染的1/2/4/8bpp字体
+ * @param fg 文字颜色
+ * @param bg 文字下面的纯色背景
+ * @return false: 颜色组已满、内存不足或字体不支持
+ */
+bool digit_readout_atlas_add(const lv_font_t *font, lv_color_t fg, lv_color_t bg) {
+	for (uint8_t i = 0; i < atlas_cnt; i++) {
+		if (atlas[i].font == font && atlas[i].fg.full == fg.full && atlas[i].bg.full == bg.full) return true;
+	}
+	if (atlas_cnt >= DIGIT_READOUT_ATLAS_SLOTS) return false;
+
+	//先算出所有字形的像素数，一次分配
+	lv_font_glyph_dsc_t g[ATLAS_GLYPHS];
+	uint32_t px_cnt = 0;
+	for (uint8_t i = 0; i < ATLAS_GLYPHS; i++) {
+		if (atlas_glyph_dsc(font, (char)('0' + i), &g[i])) px_cnt += (uint32_t)g[i].box_w * g[i].box_h;
+		else g[i].box_w = 0;
+	}
+	if (px_cnt == 0) return false;
+
+	lv_color_t *buf = lv_mem_alloc(px_cnt * sizeof(lv_color_t));
+	if (buf == NULL) return false;
+
+	atlas_slot_t *slot = &atlas[atlas_cnt];
+	lv_memset_00(slot, sizeof(atlas_slot_t));
+	slot->font = font;
+	slot->fg = fg;
+	slot->bg = bg;
+	slot->buf = buf;
+
+	lv_color_t *px = buf;
+	for (uint8_t i = 0; i < ATLAS_GLYPHS; i++) {
+		if (g[i].box_w == 0) continue;
+		const uint8_t *map = lv_font_get_glyph_bitmap(font, '0' + i);
+		if (map == NULL) continue;
+
+		atlas_glyph_t *glyph = &slot->glyphs[i];
+		glyph->ofs_x = g[i].ofs_x;
+		glyph->ofs_y = (lv_coord_t)(font->line_height - font->base_line - g[i].box_h - g[i].ofs_y);
+		glyph->w = (lv_coord_t)g[i].box_w;
+		glyph->h = (lv_coord_t)g[i].box_h;
+		glyph->px = px;
+		atlas_blend(px, map, &g[i], fg, bg);
+		px += (uint32_t)g[i].box_w * g[i].box_h;
+	}
+
+	atlas_cnt++;
+	atlas_stats.slots = atlas_cnt;
+	atlas_stats.bytes += px_cnt * sizeof(lv_color_t);
+	return true;
+}
+
+/**
+ * @brief 释放所有贴图，之后的绘制全部走lv_draw_letter
+ */
+void digit_readout_atlas_clear(void) {
+	for (uint8_t i = 0; i < atlas_cnt; i++) lv_mem_free(atlas[i].buf);
+	lv_memset_00(atlas, sizeof(atlas));
+	atlas_cnt = 0;
+	atlas_stats.slots = 0;
+	atlas_stats.bytes = 0;
+}
+
+void digit_readout_atlas_get_stats(digit_readout_atlas_stats_t *stats) {
+	*stats = atlas_stats;
+}
+#endif
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void digit_readout_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj) {
+	LV_UNUSED(class_p);
+	digit_readout_t *readout = (digit_readout_t *)obj;
+
+	readout->cell_cnt = 0;
+	lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+	refresh_cell_width(obj);
+}
+
+static void digit_readout_event(const lv_obj_class_t *class_p, lv_event_t *e) {
+	LV_UNUSED(class_p);
+
+	lv_res_t res = lv_obj_event_base(MY_CLASS, e);
+	if (res != LV_RES_OK) return;
+
+	lv_event_code_t code = lv_event_get_code(e);
+	lv_obj_t *obj = lv_event_get_target(e);
+	digit_readout_t *readout = (digit_readout_t *)obj;
+
+	if (code == LV_EVENT_STYLE_CHANGED) {
+		refresh_cell_width(obj);
+		lv_obj_refresh_self_size(obj);
+	} else if (code == LV_EVENT_GET_SELF_SIZE) {
+		lv_point_t *p = lv_event_get_param(e);
+		const lv_font_t *font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+		p->x = LV_MAX(p->x, readout->cell_cnt * readout->cell_w);
+		p->y = LV_MAX(p->y, lv_font_get_line_height(font));
+	} else if (code == LV_EVENT_DRAW_MAIN) {
+		draw_cells(e);
+	}
+}
+
+static void refresh_cell_width(lv_obj_t *obj) {
+	digit_readout_t *readout = (digit_readout_t *)obj;
+	const lv_font_t *font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+	readout->cell_w = (lv_coord_t)lv_font_get_glyph_width(font, '0', '0');
+}
+
+static void invalidate_cell(lv_obj_t *obj, uint8_t idx) {
+	lv_area_t area;
+	digit_readout_get_cell_area(obj, idx, &area);
+	lv_obj_invalidate_area(obj, &area);
+}
+
+/**
+ * @brief 逐格绘制，和剪切区域不相交的格直接跳过
+ */
+static void draw_cells(lv_event_t *e) {
+	lv_obj_t *obj = lv_event_get_target(e);
+	lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+	digit_readout_t *readout = (digit_readout_t *)obj;
+
+	lv_draw_label_dsc_t dsc;
+	lv_draw_label_dsc_init(&dsc);
+	lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &dsc);
+
+	for (uint8_t i = 0; i < readout->cell_cnt; i++) {
+		if (readout->cells[i] == ' ') continue;
+
+		lv_area_t cell_area, common;
+		digit_readout_get_cell_area(obj, i, &cell_area);
+		if (!_lv_area_intersect(&common, &cell_area, draw_ctx->clip_area)) continue;
+
+		lv_point_t pos = {cell_area.x1, cell_area.y1};
+		dsc.color = readout->colors[i];
+#if DIGIT_READOUT_USE_ATLAS
+		if (atlas_draw(draw_ctx, &dsc, &pos, readout->cells[i])) continue;
+#endif
+		lv_draw_letter(draw_ctx, &dsc, &pos, (uint32_t)readout->cells[i]);
+	}
+}
+
+#if DIGIT_READOUT_USE_ATLAS
+static bool atlas_glyph_dsc(const lv_font_t *font, char ch, lv_font_glyph_dsc_t *g) {
+	if (!lv_font_get_glyph_dsc(font, g, (uint32_t)ch, '\0')) return false;
+	if (g->resolved_font != font || font->subpx != LV_FONT_SUBPX_NONE) return false;
+	if (g->bpp != 1 && g->bpp != 2 && g->bpp != 4 && g->bpp != 8) return false;
+	return g->box_w != 0 && g->box_h != 0;
+}
+
+/**
+ * @brief 字形位图逐像素换算成遮罩再和背景混合，位图按行连续存放，行末不补齐
+ */
+static void atlas_blend(lv_color_t *dest, const uint8_t *map, const lv_font_glyph_dsc_t *g, lv_color_t fg,
+						lv_color_t bg) {
+	uint8_t bpp = g->bpp;
+	uint8_t px_max = (uint8_t)((1u << bpp) - 1);
+	uint32_t px_cnt = (uint32_t)g->box_w * g->box_h;
+	uint32_t bit = 0;
+
+	for (uint32_t i = 0; i < px_cnt; i++, bit += bpp) {
+		uint8_t letter_px = (map[bit >> 3] >> (8 - bpp - (bit & 0x7))) & px_max;
+		//和_lv_bppN_opa_table一致
+		lv_opa_t mask = (lv_opa_t)(letter_px * LV_OPA_COVER / px_max);
+		if (mask == LV_OPA_TRANSP) dest[i] = bg;
+		else if (mask == LV_OPA_COVER) dest[i] = fg;
+		else dest[i] = lv_color_mix(fg, bg, mask);
+	}
+}
+
+/**
+ * @brief 用贴图画一个数字：要求软件渲染、不透明、没有遮罩，并且字形框下面全是登记过的背景色
+ * 绘制缓冲必须是普通的lv_color_t缓冲：panel淡入淡出时的带alpha通道的层（screen_transp置1）每像素3字节，不能使用
+ * @return false: 条件不满足，需要调用lv_draw_letter
+ */
+static bool atlas_draw(lv_draw_ctx_t *draw_ctx, const lv_draw_label_dsc_t *dsc, const lv_point_t *pos, char ch) {
+	if (ch < '0' || ch > '9') return false;
+	if (draw_ctx->draw_letter != lv_draw_sw_letter) return false;
+	if (dsc->opa < LV_OPA_MAX || dsc->blend_mode != LV_BLEND_MODE_NORMAL) return false;
+	const lv_disp_drv_t *drv = _lv_refr_get_disp_refreshing()->driver;
+	if (!drv->antialiasing || drv->screen_transp || drv->set_px_cb) return false;
+
+	//同一字体和前景色可能登记了几种背景，先按第一个像素挑出背景相同的那一组
+	const atlas_glyph_t *glyph = NULL;
+	const atlas_slot_t *slot = NULL;
+	lv_area_t box, common;
+	lv_color_t *dest = NULL;
+	lv_coord_t buf_w = lv_area_get_width(draw_ctx->buf_area);
+	bool candidate = false;
+
+	for (uint8_t i = 0; i < atlas_cnt; i++) {
+		if (atlas[i].font != dsc->font || atlas[i].fg.full != dsc->color.full) continue;
+		if (atlas[i].glyphs[ch - '0'].px == NULL) continue;
+		candidate = true;
+
+		if (glyph == NULL) {
+			glyph = &atlas[i].glyphs[ch - '0'];
+			box.x1 = pos->x + glyph->ofs_x;
+			box.y1 = pos->y + glyph->ofs_y;
+			box.x2 = box.x1 + glyph->w - 1;
+			box.y2 = box.y1 + glyph->h - 1;
+			//完全在剪切区域之外，lv_draw_letter同样什么都不画
+			if (!_lv_area_intersect(&common, &box, draw_ctx->clip_area)) return true;
+			if (lv_draw_mask_is_any(&common)) return false;
+			dest = (lv_color_t *)draw_ctx->buf + (int32_t)(common.y1 - draw_ctx->buf_area->y1) * buf_w +
+				   (common.x1 - draw_ctx->buf_area->x1);
+		}
+		if (dest->full == atlas[i].bg.full) {
+			slot = &atlas[i];
+			break;
+		}
+	}
+	if (!candidate) return false;
+	if (slot == NULL) {
+		atlas_stats.misses++;
+		return false;
+	}
+
+	//贴图会覆盖整个字形框，框内任何一个像素不是背景色都不能用
+	lv_coord_t w = lv_area_get_width(&common);
+	lv_coord_t h = lv_area_get_height(&common);
+	const lv_color_t *row = dest;
+	for (lv_coord_t y = 0; y < h; y++, row += buf_w) {
+		for (lv_coord_t x = 0; x < w; x++) {
+			if (row[x].full != slot->bg.full) {
+				atlas_stats.misses++;
+				return false;
+			}
+		}
+	}
+
+	glyph = &slot->glyphs[ch - '0'];
+	const lv_color_t *src = glyph->px + (int32_t)(common.y1 - box.y1) * glyph->w + (common.x1 - box.x1);
+	for (lv_coord_t y = 0; y < h; y++) {
+		lv_memcpy(dest, src, w * sizeof(lv_color_t));
+		dest += buf_w;
+		src += glyph->w;
+	}
+	atlas_stats.hits++;
+	return true;
+}
+#endif
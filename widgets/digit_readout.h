@@ -0,0 +1,82 @@
+/**
+ * @file digit_readout.h
+ * 定宽数字读数控件：按字符格存储数字和每一格的颜色，
+ * 数值变化时只重绘发生变化的字符格
+ */
+
+#ifndef DIGIT_READOUT_H
+#define DIGIT_READOUT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define DIGIT_READOUT_MAX_CELLS		(16)
+
+/*
+ * 置1时启用预混合的数字贴图：每一组(字体, 前景色, 背景色)预先把'0'~'9'和背景混合成RGB565图像，
+ * 绘制时如果字形框下面正好是这个纯色背景，就直接按行拷贝，不再逐像素混合；否则照常调用lv_draw_letter
+ */
+#ifndef DIGIT_READOUT_USE_ATLAS
+#define DIGIT_READOUT_USE_ATLAS		0
+#endif
+
+/*最多能登记的颜色组数，每组占用10个数字字形框大小的显存格式图像*/
+#ifndef DIGIT_READOUT_ATLAS_SLOTS
+#define DIGIT_READOUT_ATLAS_SLOTS	(8)
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+	lv_obj_t obj;
+	lv_coord_t cell_w;							//每一格的宽度，取字体中'0'的宽度
+	uint8_t cell_cnt;
+	char cells[DIGIT_READOUT_MAX_CELLS];
+	lv_color_t colors[DIGIT_READOUT_MAX_CELLS];
+} digit_readout_t;
+
+extern const lv_obj_class_t digit_readout_class;
+
+#if DIGIT_READOUT_USE_ATLAS
+typedef struct {
+	uint32_t hits;								//直接拷贝贴图的数字个数
+	uint32_t misses;							//登记过颜色但背景不符等原因，退回lv_draw_letter的数字个数
+	uint32_t bytes;								//所有贴图占用的内存
+	uint8_t slots;								//已登记的颜色组数
+} digit_readout_atlas_stats_t;
+#endif
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+lv_obj_t *digit_readout_create(lv_obj_t *parent);
+
+void digit_readout_set_text(lv_obj_t *obj, uint8_t start, const char *txt, lv_color_t color);
+void digit_readout_set_cell(lv_obj_t *obj, uint8_t idx, char ch, lv_color_t color);
+void digit_readout_set_number(lv_obj_t *obj, uint8_t start, uint8_t width, uint32_t value,
+							  lv_color_t color, lv_color_t lead_color);
+
+uint8_t digit_readout_get_cell_count(const lv_obj_t *obj);
+void digit_readout_get_cell_area(const lv_obj_t *obj, uint8_t idx, lv_area_t *area);
+
+#if DIGIT_READOUT_USE_ATLAS
+bool digit_readout_atlas_add(const lv_font_t *font, lv_color_t fg, lv_color_t bg);
+void digit_readout_atlas_clear(void);
+void digit_readout_atlas_get_stats(digit_readout_atlas_stats_t *stats);
+#endif
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif //DIGIT_READOUT_H
@@ -0,0 +1,223 @@
+/**
+ * @file power_gauge.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "power_gauge.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define MY_CLASS &power_gauge_class
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void power_gauge_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj);
+static void power_gauge_event(const lv_obj_class_t *class_p, lv_event_t *e);
+static void get_inner_area(const lv_obj_t *obj, lv_area_t *area, lv_coord_t *radius);
+static void apply_value(lv_obj_t *obj, int32_t value);
+static void anim_value_cb(void *var, int32_t v);
+static void draw_fill(lv_event_t *e);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+const lv_obj_class_t power_gauge_class = {
+	.base_class = &lv_obj_class,
+	.constructor_cb = power_gauge_constructor,
+	.event_cb = power_gauge_event,
+	.instance_size = sizeof(power_gauge_t),
+};
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * @brief 创建功率占比条，大小应和父panel一致，填充区域限定在父panel边框以内
+ * @param parent 父panel
+ * @return 创建的控件
+ */
+lv_obj_t *power_gauge_create(lv_obj_t *parent) {
+	lv_obj_t *obj = lv_obj_class_create_obj(MY_CLASS, parent);
+	lv_obj_class_init_obj(obj);
+	return obj;
+}
+
+/**
+ * @brief 设置遮罩颜色和不透明度，绘制时预先和父panel背景色混合成不透明颜色
+ */
+void power_gauge_set_shade(lv_obj_t *obj, lv_color_t color, lv_opa_t opa) {
+	power_gauge_t *gauge = (power_gauge_t *)obj;
+	gauge->shade_color = color;
+	gauge->shade_opa = opa;
+	lv_obj_invalidate(obj);
+}
+
+/**
+ * @brief 设置数值变化的动画时长
+ */
+void power_gauge_set_anim_time(lv_obj_t *obj, uint32_t anim_time) {
+	((power_gauge_t *)obj)->anim_time = anim_time;
+}
+
+/**
+ * @brief 设置数值
+ * 动画进行中时直接修改正在运行的动画，从当前显示值驶向新目标，不重新创建动画
+ * @param obj 功率占比条
+ * @param value 数值，范围0 ~ POWER_GAUGE_RANGE
+ * @param anim_en 是否使用动画
+ */
+void power_gauge_set_value(lv_obj_t *obj, int32_t value, lv_anim_enable_t anim_en) {
+	power_gauge_t *gauge = (power_gauge_t *)obj;
+	value = LV_CLAMP(0, value, POWER_GAUGE_RANGE);
+	gauge->target = value;
+
+	if (anim_en == LV_ANIM_OFF || gauge->anim_time == 0) {
+		lv_anim_del(obj, anim_value_cb);
+		apply_value(obj, value);
+		return;
+	}
+
+	lv_anim_t *running = lv_anim_get(obj, anim_value_cb);
+	if (running) {
+		running->start_value = gauge->value;
+		running->current_value = gauge->value;
+		running->end_value = value;
+		running->act_time = 0;
+		return;
+	}
+
+	if (value == gauge->value) return;
+
+	lv_anim_t a;
+	lv_anim_init(&a);
+	lv_anim_set_var(&a, obj);
+	lv_anim_set_exec_cb(&a, anim_value_cb);
+	lv_anim_set_values(&a, gauge->value, value);
+	lv_anim_set_time(&a, gauge->anim_time);
+	lv_anim_set_path_cb(&a, lv_anim_path_linear);
+	lv_anim_start(&a);
+}
+
+/**
+ * @brief 获取目标数值
+ */
+int32_t power_gauge_get_value(const lv_obj_t *obj) {
+	return ((const power_gauge_t *)obj)->target;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void power_gauge_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj) {
+	LV_UNUSED(class_p);
+	power_gauge_t *gauge = (power_gauge_t *)obj;
+
+	gauge->value = 0;
+	gauge->target = 0;
+	gauge->edge = 0;
+	gauge->anim_time = 0;
+	gauge->shade_color = lv_color_black();
+	gauge->shade_opa = LV_OPA_20;
+	lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+}
+
+static void power_gauge_event(const lv_obj_class_t *class_p, lv_event_t *e) {
+	LV_UNUSED(class_p);
+
+	//只画填充部分，自身的背景和边框不需要
+	lv_event_code_t code = lv_event_get_code(e);
+	if (code == LV_EVENT_DRAW_MAIN) {
+		draw_fill(e);
+		return;
+	}
+
+	lv_res_t res = lv_obj_event_base(MY_CLASS, e);
+	if (res != LV_RES_OK) return;
+
+	if (code == LV_EVENT_SIZE_CHANGED) {
+		lv_obj_t *obj = lv_event_get_target(e);
+		apply_value(obj, ((power_gauge_t *)obj)->value);
+	}
+}
+
+/**
+ * @brief 填充区域：父panel去掉边框后的区域，圆角随父panel
+ */
+static void get_inner_area(const lv_obj_t *obj, lv_area_t *area, lv_coord_t *radius) {
+	const lv_obj_t *parent = lv_obj_get_parent(obj);
+	lv_coord_t bw = lv_obj_get_style_border_width(parent, LV_PART_MAIN);
+
+	lv_area_copy(area, &parent->coords);
+	lv_area_increase(area, -bw, -bw);
+
+	lv_coord_t r = lv_obj_get_style_radius(parent, LV_PART_MAIN);
+	lv_coord_t short_side = LV_MIN(lv_area_get_width(&parent->coords), lv_area_get_height(&parent->coords));
+	r = LV_MIN(r, short_side / 2);
+	*radius = LV_MAX(r - bw, 0);
+}
+
+/**
+ * @brief 更新显示值，只重绘新旧边缘之间的竖条
+ */
+static void apply_value(lv_obj_t *obj, int32_t value) {
+	power_gauge_t *gauge = (power_gauge_t *)obj;
+	gauge->value = value;
+
+	lv_area_t inner;
+	lv_coord_t radius;
+	get_inner_area(obj, &inner, &radius);
+
+	lv_coord_t edge = (lv_coord_t)((value * lv_area_get_width(&inner)) / POWER_GAUGE_RANGE);
+	if (edge == gauge->edge) return;
+
+	lv_area_t strip = inner;
+	strip.x1 = inner.x1 + LV_MIN(edge, gauge->edge);
+	strip.x2 = inner.x1 + LV_MAX(edge, gauge->edge) - 1;
+	gauge->edge = edge;
+	lv_obj_invalidate_area(obj, &strip);
+}
+
+static void anim_value_cb(void *var, int32_t v) {
+	apply_value((lv_obj_t *)var, v);
+}
+
+/**
+ * @brief 用不透明的混合色画出[内部左侧, 边缘)，文字画在其上方，不再有半透明层叠在文字上
+ */
+static void draw_fill(lv_event_t *e) {
+	lv_obj_t *obj = lv_event_get_target(e);
+	lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+	power_gauge_t *gauge = (power_gauge_t *)obj;
+	if (gauge->edge <= 0) return;
+
+	lv_area_t inner;
+	lv_coord_t radius;
+	get_inner_area(obj, &inner, &radius);
+
+	lv_area_t fill = inner;
+	fill.x2 = inner.x1 + gauge->edge - 1;
+
+	lv_area_t clip;
+	if (!_lv_area_intersect(&clip, &fill, draw_ctx->clip_area)) return;
+
+	lv_color_t bg = lv_obj_get_style_bg_color(lv_obj_get_parent(obj), LV_PART_MAIN);
+
+	lv_draw_rect_dsc_t dsc;
+	lv_draw_rect_dsc_init(&dsc);
+	dsc.bg_color = lv_color_mix(gauge->shade_color, bg, gauge->shade_opa);
+	dsc.bg_opa = LV_OPA_COVER;
+	dsc.radius = radius;
+
+	//画完整的圆角矩形但把剪切区域限制在填充部分，左侧保留圆角，右侧边缘是直的
+	const lv_area_t *clip_ori = draw_ctx->clip_area;
+	draw_ctx->clip_area = &clip;
+	lv_draw_rect(draw_ctx, &dsc, &inner);
+	draw_ctx->clip_area = clip_ori;
+}
@@ -0,0 +1,54 @@
+/**
+ * @file power_gauge.h
+ * 功率占比条：在父panel内部从左往右填充一段不透明的加深色，
+ * 用来代替整块半透明遮罩层的滑动动画
+ */
+
+#ifndef POWER_GAUGE_H
+#define POWER_GAUGE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define POWER_GAUGE_RANGE		(1000)		//数值范围0 ~ 1000（千分比）
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+	lv_obj_t obj;
+	int32_t value;					//当前显示的值（动画中间值）
+	int32_t target;					//目标值
+	lv_coord_t edge;				//填充边缘相对于内部区域左侧的偏移(px)
+	uint32_t anim_time;
+	lv_color_t shade_color;
+	lv_opa_t shade_opa;
+} power_gauge_t;
+
+extern const lv_obj_class_t power_gauge_class;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+lv_obj_t *power_gauge_create(lv_obj_t *parent);
+
+void power_gauge_set_shade(lv_obj_t *obj, lv_color_t color, lv_opa_t opa);
+void power_gauge_set_anim_time(lv_obj_t *obj, uint32_t anim_time);
+void power_gauge_set_value(lv_obj_t *obj, int32_t value, lv_anim_enable_t anim_en);
+
+int32_t power_gauge_get_value(const lv_obj_t *obj);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif //POWER_GAUGE_H
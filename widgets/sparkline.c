@@ -0,0 +1,280 @@
+/**
+ * @file sparkline.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "sparkline.h"
+#include "src/draw/sw/lv_draw_sw.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define MY_CLASS &sparkline_class
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void sparkline_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj);
+static void sparkline_event(const lv_obj_class_t *class_p, lv_event_t *e);
+static lv_coord_t value_to_y(const sparkline_t *spark, int32_t value);
+static void set_span(sparkline_t *spark, uint16_t idx, lv_coord_t y, lv_coord_t prev_y);
+static void push_point(lv_obj_t *obj, int32_t value);
+static void rebuild_spans(lv_obj_t *obj);
+static bool can_write_direct(lv_draw_ctx_t *draw_ctx, const lv_area_t *clip, lv_opa_t opa);
+static void draw_spans(lv_event_t *e);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+const lv_obj_class_t sparkline_class = {
+	.base_class = &lv_obj_class,
+	.constructor_cb = sparkline_constructor,
+	.event_cb = sparkline_event,
+	.instance_size = sizeof(sparkline_t),
+};
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * @brief 创建趋势线控件，宽度超过SPARKLINE_MAX_POINTS的部分不显示
+ * @param parent 父对象
+ * @return 创建的控件
+ */
+lv_obj_t *sparkline_create(lv_obj_t *parent) {
+	lv_obj_t *obj = lv_obj_class_create_obj(MY_CLASS, parent);
+	lv_obj_class_init_obj(obj);
+	return obj;
+}
+
+/**
+ * @brief 设置纵轴范围，会按新范围重新计算全部点
+ */
+void sparkline_set_range(lv_obj_t *obj, int32_t min, int32_t max) {
+	sparkline_t *spark = (sparkline_t *)obj;
+	if (max <= min) max = min + 1;
+	if (spark->range_min == min && spark->range_max == max) return;
+
+	spark->range_min = min;
+	spark->range_max = max;
+	rebuild_spans(obj);
+}
+
+/**
+ * @brief 设置抽取倍数：每decimation个原始采样取平均后作为一个点
+ */
+void sparkline_set_decimation(lv_obj_t *obj, uint8_t decimation) {
+	sparkline_t *spark = (sparkline_t *)obj;
+	spark->decimation = decimation ? decimation : 1;
+	spark->acc_cnt = 0;
+	spark->acc_sum = 0;
+}
+
+/**
+ * @brief 设置线条颜色
+ */
+void sparkline_set_line_color(lv_obj_t *obj, lv_color_t color) {
+	sparkline_t *spark = (sparkline_t *)obj;
+	if (spark->line_color.full == color.full) return;
+
+	spark->line_color = color;
+	lv_obj_invalidate(obj);
+}
+
+/**
+ * @brief 加入一个原始采样，攒够decimation个后生成一个新点并左移一列
+ */
+void sparkline_add_sample(lv_obj_t *obj, int32_t value) {
+	sparkline_t *spark = (sparkline_t *)obj;
+	spark->acc_sum += value;
+	spark->acc_cnt++;
+	if (spark->acc_cnt < spark->decimation) return;
+
+	int32_t avg = spark->acc_sum / spark->acc_cnt;
+	spark->acc_sum = 0;
+	spark->acc_cnt = 0;
+	push_point(obj, avg);
+}
+
+/**
+ * @brief 清空所有点
+ */
+void sparkline_clear(lv_obj_t *obj) {
+	sparkline_t *spark = (sparkline_t *)obj;
+	spark->head = 0;
+	spark->count = 0;
+	spark->acc_cnt = 0;
+	spark->acc_sum = 0;
+	lv_obj_invalidate(obj);
+}
+
+/**
+ * @brief 获取环形缓冲区中的点数
+ */
+uint16_t sparkline_get_point_count(const lv_obj_t *obj) {
+	return ((const sparkline_t *)obj)->count;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void sparkline_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj) {
+	LV_UNUSED(class_p);
+	sparkline_t *spark = (sparkline_t *)obj;
+
+	spark->head = 0;
+	spark->count = 0;
+	spark->range_min = 0;
+	spark->range_max = 100;
+	spark->decimation = 1;
+	spark->acc_cnt = 0;
+	spark->acc_sum = 0;
+	spark->line_color = lv_color_black();
+	spark->last_y = 0;
+	spark->h = 1;
+	lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+}
+
+static void sparkline_event(const lv_obj_class_t *class_p, lv_event_t *e) {
+	LV_UNUSED(class_p);
+
+	//背景和边框都不需要，只画线条
+	lv_event_code_t code = lv_event_get_code(e);
+	if (code == LV_EVENT_DRAW_MAIN) {
+		draw_spans(e);
+		return;
+	}
+
+	lv_res_t res = lv_obj_event_base(MY_CLASS, e);
+	if (res != LV_RES_OK) return;
+
+	if (code == LV_EVENT_SIZE_CHANGED) {
+		rebuild_spans(lv_event_get_target(e));
+	}
+}
+
+static lv_coord_t value_to_y(const sparkline_t *spark, int32_t value) {
+	value = LV_CLAMP(spark->range_min, value, spark->range_max);
+	int32_t span = spark->range_max - spark->range_min;
+	return (lv_coord_t)(spark->h - 1 - ((value - spark->range_min) * (spark->h - 1)) / span);
+}
+
+/**
+ * @brief 第idx个点的一列：把上一列的y和本列的y连成一段竖线
+ */
+static void set_span(sparkline_t *spark, uint16_t idx, lv_coord_t y, lv_coord_t prev_y) {
+	spark->spans[idx].y1 = (uint8_t)LV_MIN(y, prev_y);
+	spark->spans[idx].y2 = (uint8_t)LV_MAX(y, prev_y);
+}
+
+/**
+ * @brief 写入一个新点：旧的列随环形缓冲区的头整体左移，只计算最新一列
+ */
+static void push_point(lv_obj_t *obj, int32_t value) {
+	sparkline_t *spark = (sparkline_t *)obj;
+
+	value = LV_CLAMP(INT16_MIN, value, INT16_MAX);
+	lv_coord_t y = value_to_y(spark, value);
+	spark->points[spark->head] = (int16_t)value;
+	set_span(spark, spark->head, y, spark->count ? spark->last_y : y);
+	spark->last_y = y;
+
+	spark->head = (spark->head + 1) % SPARKLINE_MAX_POINTS;
+	if (spark->count < SPARKLINE_MAX_POINTS) spark->count++;
+
+	//画了点的列在屏幕上都平移了一个像素，只有还没画满时左边空白的部分不用重绘
+	lv_coord_t w = LV_MIN(lv_area_get_width(&obj->coords), SPARKLINE_MAX_POINTS);
+	lv_coord_t n = LV_MIN(spark->count, w);
+	lv_area_t area;
+	lv_area_set(&area, obj->coords.x1 + w - n, obj->coords.y1, obj->coords.x1 + w - 1, obj->coords.y1 + spark->h - 1);
+	lv_obj_invalidate_area(obj, &area);
+}
+
+/**
+ * @brief 按当前高度和范围重新计算全部列，只在大小或范围变化时使用
+ */
+static void rebuild_spans(lv_obj_t *obj) {
+	sparkline_t *spark = (sparkline_t *)obj;
+	spark->h = LV_CLAMP(1, lv_obj_get_height(obj), UINT8_MAX + 1);
+
+	uint16_t idx = (spark->head + SPARKLINE_MAX_POINTS - spark->count) % SPARKLINE_MAX_POINTS;
+	lv_coord_t prev_y = 0;
+	for (uint16_t i = 0; i < spark->count; i++) {
+		lv_coord_t y = value_to_y(spark, spark->points[idx]);
+		set_span(spark, idx, y, i ? prev_y : y);
+		prev_y = y;
+		idx = (idx + 1) % SPARKLINE_MAX_POINTS;
+	}
+	spark->last_y = prev_y;
+
+	lv_obj_invalidate(obj);
+}
+
+/**
+ * @brief 能否把线条像素直接写进绘制缓冲：软件渲染的普通缓冲，不透明，没有蒙版
+ * panel淡入淡出时LVGL把它画进带alpha通道的层（每像素3字节，screen_transp置1），这时不能按lv_color_t写
+ */
+static bool can_write_direct(lv_draw_ctx_t *draw_ctx, const lv_area_t *clip, lv_opa_t opa) {
+	if (opa < LV_OPA_MAX) return false;
+	if (((lv_draw_sw_ctx_t *)draw_ctx)->blend != lv_draw_sw_blend_basic) return false;
+
+	const lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+	if (disp->driver->set_px_cb || disp->driver->screen_transp) return false;
+	if (lv_draw_mask_is_any(clip)) return false;
+
+	if (draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
+	return true;
+}
+
+/**
+ * @brief 最新的点在最右侧一列，向左依次是更早的点
+ * 条件允许时直接把线条像素写进绘制缓冲，只访问线条本身的像素；否则逐列交给lv_draw_rect
+ */
+static void draw_spans(lv_event_t *e) {
+	lv_obj_t *obj = lv_event_get_target(e);
+	lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+	sparkline_t *spark = (sparkline_t *)obj;
+	if (spark->count == 0) return;
+
+	lv_coord_t w = LV_MIN(lv_area_get_width(&obj->coords), SPARKLINE_MAX_POINTS);
+	lv_area_t area, clip;
+	lv_area_set(&area, obj->coords.x1, obj->coords.y1, obj->coords.x1 + w - 1, obj->coords.y1 + spark->h - 1);
+	if (!_lv_area_intersect(&clip, &area, draw_ctx->clip_area)) return;
+
+	//最右一列是最新的点(head - 1)，再往左是更早的点
+	uint16_t n = LV_MIN(spark->count, (uint16_t)w);
+	lv_coord_t x1 = LV_MAX(clip.x1, area.x2 - n + 1);
+	if (x1 > clip.x2) return;
+	uint16_t idx = (spark->head + SPARKLINE_MAX_POINTS - (area.x2 - x1 + 1)) % SPARKLINE_MAX_POINTS;
+
+	lv_opa_t opa = lv_obj_get_style_opa(obj, LV_PART_MAIN);
+	bool direct = can_write_direct(draw_ctx, &clip, opa);
+
+	lv_draw_rect_dsc_t dsc;
+	lv_draw_rect_dsc_init(&dsc);
+	dsc.bg_color = spark->line_color;
+	dsc.bg_opa = opa;
+
+	lv_coord_t stride = lv_area_get_width(draw_ctx->buf_area);
+	lv_color_t *buf = draw_ctx->buf;
+
+	for (lv_coord_t x = x1; x <= clip.x2; x++) {
+		lv_coord_t y1 = LV_MAX(area.y1 + spark->spans[idx].y1, clip.y1);
+		lv_coord_t y2 = LV_MIN(area.y1 + spark->spans[idx].y2, clip.y2);
+		idx = (idx + 1) % SPARKLINE_MAX_POINTS;
+		if (y1 > y2) continue;
+
+		if (direct) {
+			lv_color_t *p = buf + (y1 - draw_ctx->buf_area->y1) * stride + (x - draw_ctx->buf_area->x1);
+			for (lv_coord_t y = y1; y <= y2; y++, p += stride) *p = spark->line_color;
+		} else {
+			lv_area_t col = {x, y1, x, y2};
+			lv_draw_rect(draw_ctx, &dsc, &col);
+		}
+	}
+}
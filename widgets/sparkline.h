@@ -0,0 +1,69 @@
+/**
+ * @file sparkline.h
+ * 趋势线控件：环形缓冲区保存抽取后的采样点和每一列线条的纵向范围，
+ * 新采样到来时整体左移一列（只移动环形缓冲区的头），只计算最新的一列；
+ * 屏幕上所有列都平移了一个像素，画了点的整段宽度仍然要重画和发送到屏幕
+ */
+
+#ifndef SPARKLINE_H
+#define SPARKLINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define SPARKLINE_MAX_POINTS	(240)		//环形缓冲区长度，也是控件宽度的上限
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+/*每一列线条覆盖的行[y1, y2]，相对控件顶部*/
+typedef struct {
+	uint8_t y1;
+	uint8_t y2;
+} sparkline_span_t;
+
+typedef struct {
+	lv_obj_t obj;
+	int16_t points[SPARKLINE_MAX_POINTS];	//抽取后的采样点，超出int16_t的值饱和
+	sparkline_span_t spans[SPARKLINE_MAX_POINTS];	//和points一一对应
+	uint16_t head;							//下一个写入位置
+	uint16_t count;
+	int32_t range_min;
+	int32_t range_max;
+	uint8_t decimation;						//每多少个原始采样合成一个点
+	uint8_t acc_cnt;
+	int32_t acc_sum;
+	lv_color_t line_color;
+	lv_coord_t last_y;						//最新一列的y，用于和下一列连线
+	lv_coord_t h;							//计算spans时使用的高度
+} sparkline_t;
+
+extern const lv_obj_class_t sparkline_class;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+lv_obj_t *sparkline_create(lv_obj_t *parent);
+
+void sparkline_set_range(lv_obj_t *obj, int32_t min, int32_t max);
+void sparkline_set_decimation(lv_obj_t *obj, uint8_t decimation);
+void sparkline_set_line_color(lv_obj_t *obj, lv_color_t color);
+void sparkline_add_sample(lv_obj_t *obj, int32_t value);
+void sparkline_clear(lv_obj_t *obj);
+
+uint16_t sparkline_get_point_count(const lv_obj_t *obj);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif //SPARKLINE_H